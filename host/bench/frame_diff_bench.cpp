@@ -0,0 +1,109 @@
+/**
+ * @brief 帧差分内核基准测试（主机构建）
+ *
+ * 在960x540的4bpp帧上测量FrameDiff::diffBuffers的吞吐量（每秒比较的字节数），
+ * 分别覆盖三种情况：
+ * - identical：新旧帧完全相同（最常见，视图重绘出相同像素）
+ * - sparse：少量分散的小区域变化（翻页时的页码、选中项）
+ * - full：每个字节都不同
+ *
+ * 结果与UiBenchmark一样以"FRAME_DIFF_BENCHMARK {json}"的形式逐行输出。
+ */
+#include "render/FrameDiff.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const int16_t FRAME_WIDTH = 960;
+static const int16_t FRAME_HEIGHT = 540;
+static const size_t FRAME_STRIDE = FRAME_WIDTH / 2;
+static const size_t FRAME_LENGTH = FRAME_STRIDE * FRAME_HEIGHT;
+
+/**
+ * @brief 单个场景：prev依次与frames中的帧比较
+ *
+ * diffBuffers会把变化同步到prev，所以变化场景在两帧之间交替，每次比较的变化量相同。
+ */
+struct Scenario {
+    const char* name;                         ///< 场景名称
+    std::vector<std::vector<uint8_t>> frames; ///< 轮流作为新帧
+};
+
+static void fillPattern(std::vector<uint8_t>& frame, uint32_t seed) {
+    for (size_t i = 0; i < frame.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        frame[i] = static_cast<uint8_t>(seed >> 24);
+    }
+}
+
+/**
+ * @brief 在帧上反转若干小矩形（模拟页码和选中项变化）
+ */
+static void invertSparse(std::vector<uint8_t>& frame) {
+    static const Rect spots[] = {
+        {40, 20, 120, 24},    // 标题
+        {420, 260, 96, 32},   // 选中项
+        {860, 500, 64, 24},   // 页码
+        {8, 300, 4, 4},       // 单个孤立像素块
+    };
+    for (const Rect& spot : spots) {
+        for (int16_t y = spot.y; y < spot.bottom(); y++) {
+            for (int16_t x = spot.x / 2; x < (spot.right() + 1) / 2; x++) {
+                frame[y * FRAME_STRIDE + x] ^= 0xFF;
+            }
+        }
+    }
+}
+
+static void runScenario(const Scenario& scenario, const std::vector<uint8_t>& initial, int iterations) {
+    std::vector<uint8_t> prev(initial);
+    const Rect area{0, 0, FRAME_WIDTH, FRAME_HEIGHT};
+    DirtyRegion changed;
+    size_t rects = 0;
+
+    // 预热
+    for (const auto& frame : scenario.frames) {
+        changed.clear();
+        FrameDiff::diffBuffers(prev.data(), frame.data(), FRAME_STRIDE, area, changed);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        const auto& frame = scenario.frames[i % scenario.frames.size()];
+        changed.clear();
+        FrameDiff::diffBuffers(prev.data(), frame.data(), FRAME_STRIDE, area, changed);
+        rects += changed.size();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bytes = static_cast<double>(FRAME_LENGTH) * iterations;
+    printf("FRAME_DIFF_BENCHMARK {\"case\":\"%s\",\"width\":%d,\"height\":%d,\"iterations\":%d,"
+           "\"us_per_frame\":%.1f,\"bytes_per_s\":%.0f,\"rects_per_frame\":%.1f}\n",
+           scenario.name, FRAME_WIDTH, FRAME_HEIGHT, iterations, elapsed * 1e6 / iterations, bytes / elapsed,
+           static_cast<double>(rects) / iterations);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    if (iterations <= 0) {
+        iterations = 2000;
+    }
+
+    std::vector<uint8_t> base(FRAME_LENGTH);
+    fillPattern(base, 1);
+
+    std::vector<uint8_t> sparse(base);
+    invertSparse(sparse);
+
+    std::vector<uint8_t> full(base);
+    for (auto& value : full) {
+        value ^= 0xFF;
+    }
+
+    runScenario({"identical", {base}}, base, iterations);
+    runScenario({"sparse", {sparse, base}}, base, iterations);
+    runScenario({"full", {full, base}}, base, iterations);
+    return 0;
+}
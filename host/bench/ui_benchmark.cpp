@@ -0,0 +1,48 @@
+/**
+ * @brief UI渲染基准测试（主机构建）
+ *
+ * 注册与设备相同的页面，在540x960的内存帧缓冲上运行UiBenchmark，
+ * 输出格式与设备串口相同（"UI_BENCHMARK {json}"），便于对比两端的结果。
+ * 有页面加载超时或缺少根视图时返回非零，ctest中以少量迭代作为冒烟测试运行。
+ */
+#include "benchmark/UiBenchmark.h"
+#include "page_manager/PageManager.h"
+#include "pages/launcher/LauncherPage.h"
+#include "pages/settings/SettingsPage.h"
+#include "pages/message/MessagePage.h"
+#include "pages/file_browser/PagedFileBrowserPage.h"
+#include "render/FrameBufferSurface.h"
+#include "jobs/JobScheduler.h"
+#include "lgfx/Fonts/efont/lgfx_efont_cn.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : UiBenchmark::DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        iterations = UiBenchmark::DEFAULT_ITERATIONS;
+    }
+
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.setScreenSize(540, 960);
+    pageManager.registerPage(PageType::MENU, []() { return std::make_unique<LauncherPage>(); });
+    pageManager.registerPage(PageType::SETTINGS, []() { return std::make_unique<SettingsPage>(); });
+    pageManager.registerPage(PageType::FILE_BROWSER, []() { return std::make_unique<PagedFileBrowserPage>(); });
+    pageManager.registerPage(PageType::MESSAGE, []() { return std::make_unique<MessagePage>(); });
+
+    if (!JobScheduler::getInstance().init()) {
+        printf("JobScheduler init failed\n");
+        return 1;
+    }
+
+    // 与设备上的M5.Display一样提供尺寸和字体
+    FrameBufferSurface display;
+    if (!display.create(540, 960, false, &fonts::efontCN_16_b)) {
+        printf("Failed to allocate the display surface\n");
+        return 1;
+    }
+    bool ok = UiBenchmark::run(display, iterations);
+    PageManager::getInstance().destroy();
+    return ok ? 0 : 1;
+}
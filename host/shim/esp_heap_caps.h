@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @brief 主机构建的分区堆接口
+ * 
+ * 主机上只有一个堆，所有能力标志都从同一个堆分配。
+ * 空闲内存查询返回固定值：页面管理器的内存预算在主机上不会因为"内存不足"而裁剪页面，
+ * 页面实际占用由Page::estimateRetainedBytes等接口统计。
+ */
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+#ifndef HOST_HEAP_FREE_SIZE
+#define HOST_HEAP_FREE_SIZE (4 * 1024 * 1024)
+#endif
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return HOST_HEAP_FREE_SIZE;
+}
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    (void)caps;
+    return HOST_HEAP_FREE_SIZE;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+
+/**
+ * @brief 主机构建的日志接口
+ * 
+ * 与ESP-IDF的ESP_LOGx保持相同的用法，输出到stderr。
+ * 输出级别由HOST_LOG_LEVEL决定（0关闭，1错误 ... 5详细），默认只输出警告和错误。
+ */
+#ifndef HOST_LOG_LEVEL
+#define HOST_LOG_LEVEL 2
+#endif
+
+inline uint32_t esp_log_timestamp() {
+    static const auto start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+#define HOST_LOG(level, letter, tag, format, ...)                                                       \
+    do {                                                                                                \
+        if ((level) <= HOST_LOG_LEVEL) {                                                                \
+            fprintf(stderr, letter " (%u) %s: " format "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__); \
+        }                                                                                               \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) HOST_LOG(1, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) HOST_LOG(2, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) HOST_LOG(3, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) HOST_LOG(4, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) HOST_LOG(5, "V", tag, format, ##__VA_ARGS__)
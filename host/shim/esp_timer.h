@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @brief 主机构建的计时接口：进程启动后经过的微秒数
+ */
+inline int64_t esp_timer_get_time() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 主机构建的FreeRTOS子集
+ * 
+ * 任务、队列和信号量用std::thread和条件变量实现（见freertos_host.cpp），
+ * 一个滴答等于1毫秒。只提供UI代码用到的接口，核心亲和性被忽略。
+ */
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+typedef struct HostQueue* QueueHandle_t;
+typedef struct HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+/**
+ * @brief 创建队列
+ * @param length 队列长度
+ * @param itemSize 每项字节数（信号量为0）
+ * @return 队列句柄
+ */
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+
+/**
+ * @brief 入队，队列已满时最多等待ticksToWait
+ */
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+
+/**
+ * @brief 出队，队列为空时最多等待ticksToWait
+ */
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+
+/**
+ * @brief 获取队列中的项数
+ */
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+/**
+ * @brief 删除队列
+ */
+void vQueueDelete(QueueHandle_t queue);
+
+/**
+ * @brief 创建队列并预先放入initialCount个空项（用于计数信号量和互斥锁）
+ */
+QueueHandle_t xHostQueueCreateFilled(UBaseType_t length, UBaseType_t initialCount);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xHostQueueCreateFilled(1, 0);
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return xHostQueueCreateFilled(maxCount, initialCount);
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    // 主机上的互斥锁不处理优先级继承，也不检查持有者
+    return xHostQueueCreateFilled(1, 1);
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    return xQueueReceive(semaphore, nullptr, ticksToWait);
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xQueueSend(semaphore, nullptr, 0);
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    vQueueDelete(semaphore);
+}
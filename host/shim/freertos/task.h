@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+/**
+ * @brief 创建任务（主机上为分离的线程，忽略栈大小、优先级和核心）
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId);
+
+/**
+ * @brief 创建任务
+ */
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                              UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(function, name, stackDepth, param, priority, created, 0);
+}
+
+/**
+ * @brief 获取当前任务的句柄（没有通过xTaskCreate创建的线程首次调用时分配）
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * @brief 当前任务休眠指定滴答数
+ */
+void vTaskDelay(TickType_t ticks);
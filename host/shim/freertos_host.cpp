@@ -0,0 +1,130 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 队列：信号量是项大小为0的队列
+ */
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+/**
+ * @brief 任务
+ */
+struct HostTask {
+    std::string name;
+};
+
+static thread_local HostTask* t_currentTask = nullptr;
+
+/**
+ * @brief 按滴答数等待条件成立
+ */
+template <typename Predicate>
+static bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, TickType_t ticks,
+                    Predicate predicate) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) {
+        return nullptr;
+    }
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+QueueHandle_t xHostQueueCreateFilled(UBaseType_t length, UBaseType_t initialCount) {
+    QueueHandle_t queue = xQueueCreate(length, 0);
+    if (queue != nullptr) {
+        for (UBaseType_t i = 0; i < initialCount && i < length; i++) {
+            queue->items.emplace_back();
+        }
+    }
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notFull, lock, ticksToWait, [queue]() { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    std::vector<uint8_t> data(queue->itemSize);
+    if (queue->itemSize > 0) {
+        memcpy(data.data(), item, queue->itemSize);
+    }
+    queue->items.push_back(std::move(data));
+    queue->notEmpty.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notEmpty, lock, ticksToWait, [queue]() { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    if (queue->itemSize > 0 && item != nullptr) {
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+    }
+    queue->items.pop_front();
+    queue->notFull.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->items.size());
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreId) {
+    (void)stackDepth;
+    (void)priority;
+    (void)coreId;
+    HostTask* task = new HostTask{name != nullptr ? name : ""};
+    if (created != nullptr) {
+        *created = task;
+    }
+    std::thread([function, param, task]() {
+        t_currentTask = task;
+        function(param);
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (t_currentTask == nullptr) {
+        // 主线程等不是由xTaskCreate创建的线程，整个生命周期使用同一个句柄
+        static thread_local HostTask self{"host"};
+        t_currentTask = &self;
+    }
+    return t_currentTask;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
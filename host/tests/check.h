@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @brief 主机测试的检查宏
+ *
+ * CHECK失败时打印位置并计数，不中断测试；main最后返回finishTest(名称)。
+ */
+#include <cstdio>
+
+static int s_failures = 0;
+
+#define CHECK(condition)                                                   \
+    do {                                                                   \
+        if (!(condition)) {                                                \
+            printf("[FAIL] %s:%d: %s\n", __FILE__, __LINE__, #condition);  \
+            s_failures++;                                                  \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief 输出测试结果
+ * @param name 测试名称
+ * @return 进程退出码：全部通过为0，否则为1
+ */
+static inline int finishTest(const char* name) {
+    if (s_failures != 0) {
+        printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("[ OK ] %s\n", name);
+    return 0;
+}
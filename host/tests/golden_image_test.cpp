@@ -0,0 +1,138 @@
+/**
+ * @brief 基准图像比对（主机构建）
+ *
+ * 依次打开启动器、消息页和文件浏览器，等待异步任务完成后把页面绘制到
+ * 540x960的FrameBufferSurface上，将帧内容的FNV-1a校验和与golden/中记录的值比对。
+ *
+ * - 基准文件不存在或校验和不一致时失败，不一致时把实际图像保存为PGM
+ * - 带--update参数运行时不比对，把当前校验和记录到构建目录下的golden/，
+ *   检查图像无误后再复制到源码树的host/golden/中提交
+ */
+#include "page_manager/PageManager.h"
+#include "pages/launcher/LauncherPage.h"
+#include "pages/message/MessagePage.h"
+#include "pages/file_browser/PagedFileBrowserPage.h"
+#include "render/FrameBufferSurface.h"
+#include "jobs/JobScheduler.h"
+#include "lgfx/Fonts/efont/lgfx_efont_cn.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+static const int16_t SCREEN_WIDTH = 540;
+static const int16_t SCREEN_HEIGHT = 960;
+
+/**
+ * @brief 单个页面的比对用例
+ */
+struct GoldenCase {
+    const char* name;                          ///< 基准文件名
+    PageType pageType;                         ///< 页面类型
+    std::shared_ptr<void> params;              ///< 启动参数
+};
+
+static bool readGolden(const std::string& path, uint32_t& checksum) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+    unsigned long value = 0;
+    bool ok = fscanf(file, "%lx", &value) == 1;
+    fclose(file);
+    checksum = static_cast<uint32_t>(value);
+    return ok;
+}
+
+static bool writeGolden(const std::string& path, uint32_t checksum) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "%08lx\n", static_cast<unsigned long>(checksum));
+    fclose(file);
+    return true;
+}
+
+static bool runCase(const GoldenCase& testCase, FrameBufferSurface& surface, bool update) {
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.startActivityClearTop(testCase.pageType, testCase.params);
+    if (!JobScheduler::getInstance().runUntilIdle(pdMS_TO_TICKS(5000))) {
+        printf("[FAIL] %s: background jobs did not finish\n", testCase.name);
+        return false;
+    }
+
+    surface.fillScreen(TFT_WHITE);
+    pageManager.draw(surface);
+    uint32_t actual = surface.checksum();
+
+    if (update) {
+        std::string recordPath = std::string(RECORD_DIR) + "/" + testCase.name + ".fnv";
+        std::string pgmPath = std::string(RECORD_DIR) + "/" + testCase.name + ".pgm";
+        if (!writeGolden(recordPath, actual) || !surface.savePgm(pgmPath.c_str())) {
+            printf("[FAIL] %s: cannot write %s\n", testCase.name, recordPath.c_str());
+            return false;
+        }
+        printf("[REC ] %s: %08lx -> %s\n", testCase.name, static_cast<unsigned long>(actual), recordPath.c_str());
+        return true;
+    }
+
+    std::string goldenPath = std::string(GOLDEN_DIR) + "/" + testCase.name + ".fnv";
+    uint32_t expected = 0;
+    if (!readGolden(goldenPath, expected)) {
+        printf("[FAIL] %s: missing %s (checksum %08lx, record with --update)\n", testCase.name, goldenPath.c_str(),
+               static_cast<unsigned long>(actual));
+        return false;
+    }
+
+    if (actual != expected) {
+        std::string pgmPath = std::string(OUTPUT_DIR) + "/" + testCase.name + ".actual.pgm";
+        surface.savePgm(pgmPath.c_str());
+        printf("[FAIL] %s: checksum %08lx, expected %08lx (actual image: %s)\n", testCase.name,
+               static_cast<unsigned long>(actual), static_cast<unsigned long>(expected), pgmPath.c_str());
+        return false;
+    }
+    printf("[ OK ] %s: %08lx\n", testCase.name, static_cast<unsigned long>(actual));
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.setScreenSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    pageManager.registerPage(PageType::MENU, []() { return std::make_unique<LauncherPage>(); });
+    pageManager.registerPage(PageType::MESSAGE, []() { return std::make_unique<MessagePage>(); });
+    pageManager.registerPage(PageType::FILE_BROWSER, []() { return std::make_unique<PagedFileBrowserPage>(); });
+
+    if (!JobScheduler::getInstance().init()) {
+        printf("[FAIL] JobScheduler init failed\n");
+        return 1;
+    }
+
+    FrameBufferSurface surface;
+    if (!surface.create(SCREEN_WIDTH, SCREEN_HEIGHT, false, &fonts::efontCN_16_b)) {
+        printf("[FAIL] cannot allocate frame buffer\n");
+        return 1;
+    }
+
+    const GoldenCase cases[] = {
+        {"launcher", PageType::MENU, nullptr},
+        {"message", PageType::MESSAGE, std::make_shared<std::string>("SD card initialization failed!")},
+        {"file_browser", PageType::FILE_BROWSER, nullptr},
+    };
+
+    int failures = 0;
+    for (const GoldenCase& testCase : cases) {
+        if (!runCase(testCase, surface, update)) {
+            failures++;
+        }
+    }
+
+    pageManager.destroy();
+    if (update && failures == 0) {
+        printf("Recorded checksums in %s; copy the .fnv files to %s after checking the .pgm images\n", RECORD_DIR,
+               GOLDEN_DIR);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/**
+ * @brief 后台任务调度器测试（主机构建）
+ *
+ * 主线程充当UI任务：
+ * - 工作线程全部忙碌、任务队列已满时，UI任务提交的任务不能在UI任务中同步执行
+ * - 暂存的任务在dispatchCompletions时放入队列，最终全部执行，完成回调在UI任务中执行
+ * - UI任务中调用post直接执行回调；工作线程连续post超过完成队列长度时不会死锁
+ */
+#include "check.h"
+#include "jobs/JobScheduler.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+static void testQueueFullOnUiTask() {
+    JobScheduler& scheduler = JobScheduler::getInstance();
+    const std::thread::id uiThread = std::this_thread::get_id();
+    const int jobCount = static_cast<int>(JobScheduler::QUEUE_LENGTH * 3);
+
+    std::atomic<bool> gate{false};
+    std::atomic<int> ranOnUi{0};
+    std::atomic<int> ran{0};
+    int completed = 0;
+    int completedOffUi = 0;
+
+    for (int i = 0; i < jobCount; i++) {
+        scheduler.submit(
+            [&](const JobHandle&) {
+                if (std::this_thread::get_id() == uiThread) {
+                    ranOnUi++;
+                }
+                while (!gate.load()) {
+                    vTaskDelay(1);
+                }
+                ran++;
+            },
+            [&]() {
+                completed++;
+                if (std::this_thread::get_id() != uiThread) {
+                    completedOffUi++;
+                }
+            },
+            JobPriority::HIGH);
+    }
+    // 提交全部返回，工作仍被挡住：说明没有在UI任务中同步执行
+    CHECK(ranOnUi.load() == 0);
+    CHECK(ran.load() == 0);
+
+    gate = true;
+    CHECK(scheduler.runUntilIdle(pdMS_TO_TICKS(5000)));
+    CHECK(ran.load() == jobCount);
+    CHECK(completed == jobCount);
+    CHECK(completedOffUi == 0);
+    CHECK(ranOnUi.load() == 0);
+}
+
+static void testPost() {
+    JobScheduler& scheduler = JobScheduler::getInstance();
+    const std::thread::id uiThread = std::this_thread::get_id();
+
+    // UI任务中post直接执行
+    bool direct = false;
+    JobHandle idle = scheduler.submit([](const JobHandle&) {});
+    scheduler.post(idle, [&direct]() { direct = true; });
+    CHECK(direct);
+
+    // 工作线程连续post超过完成队列长度，UI任务等待期间逐批执行
+    const int posts = static_cast<int>(JobScheduler::COMPLETION_QUEUE_LENGTH * 3);
+    int received = 0;
+    int receivedOffUi = 0;
+    scheduler.submit([&](const JobHandle& job) {
+        for (int i = 0; i < posts; i++) {
+            JobScheduler::getInstance().post(job, [&]() {
+                received++;
+                if (std::this_thread::get_id() != uiThread) {
+                    receivedOffUi++;
+                }
+            });
+        }
+    });
+    CHECK(scheduler.runUntilIdle(pdMS_TO_TICKS(5000)));
+    CHECK(received == posts);
+    CHECK(receivedOffUi == 0);
+}
+
+int main() {
+    if (!JobScheduler::getInstance().init()) {
+        printf("[FAIL] JobScheduler init failed\n");
+        return 1;
+    }
+    testQueueFullOnUiTask();
+    testPost();
+    return finishTest("job_scheduler_test");
+}
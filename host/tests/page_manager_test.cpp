@@ -0,0 +1,130 @@
+/**
+ * @brief 页面管理器测试（主机构建）
+ *
+ * - 被覆盖的栈中页面在销毁或裁剪时只暂停一次
+ * - 页面异步加载的数据（estimateRetainedBytes）计入保留预算
+ */
+#include "check.h"
+#include "page_manager/PageManager.h"
+#include <cstdio>
+#include <map>
+#include <memory>
+
+/**
+ * @brief 各类页面生命周期回调的调用次数
+ */
+struct LifecycleCounts {
+    int pause = 0;
+    int stop = 0;
+    int save = 0;
+    int destroy = 0;
+};
+
+static std::map<PageType, LifecycleCounts> s_counts;
+
+/**
+ * @brief 记录生命周期回调的测试页面
+ */
+class RecordingPage : public Page {
+public:
+    RecordingPage(PageType type, size_t loadedBytes) : Page(type, "Recording"), _loadedBytes(loadedBytes) {}
+
+    void onPause() override {
+        s_counts[getType()].pause++;
+        Page::onPause();
+    }
+
+    void onStop() override {
+        s_counts[getType()].stop++;
+        Page::onStop();
+    }
+
+    void onSaveState(PageState& state) override {
+        s_counts[getType()].save++;
+        Page::onSaveState(state);
+    }
+
+    void onDestroy() override {
+        s_counts[getType()].destroy++;
+        Page::onDestroy();
+    }
+
+    size_t estimateRetainedBytes() const override { return _loadedBytes; }
+
+private:
+    size_t _loadedBytes;  ///< 模拟后台加载的数据量
+};
+
+static const size_t LOADED_BYTES = 1024 * 1024;
+
+static void registerPages(PageManager& pageManager) {
+    pageManager.registerPage(PageType::READER, []() { return std::make_unique<RecordingPage>(PageType::READER, 4096); });
+    pageManager.registerPage(PageType::DIALOG, []() { return std::make_unique<RecordingPage>(PageType::DIALOG, 0); });
+    pageManager.registerPage(PageType::CUSTOM, []() { return std::make_unique<RecordingPage>(PageType::CUSTOM, 0); });
+    pageManager.registerPage(PageType::FILE_BROWSER,
+                             []() { return std::make_unique<RecordingPage>(PageType::FILE_BROWSER, LOADED_BYTES); });
+}
+
+static void testClearTopPausesOnce() {
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.startActivityClearTop(PageType::READER);
+    pageManager.startActivity(PageType::DIALOG);
+    s_counts.clear();
+
+    pageManager.startActivityClearTop(PageType::CUSTOM);
+    // READER被DIALOG覆盖时已经暂停过
+    CHECK(s_counts[PageType::READER].pause == 0);
+    CHECK(s_counts[PageType::READER].stop == 1);
+    CHECK(s_counts[PageType::READER].destroy == 1);
+    CHECK(s_counts[PageType::DIALOG].pause == 1);
+    CHECK(s_counts[PageType::DIALOG].stop == 1);
+    CHECK(s_counts[PageType::DIALOG].destroy == 1);
+}
+
+static void testTrimCoveredPage() {
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.startActivityClearTop(PageType::READER);
+    pageManager.startActivity(PageType::DIALOG);
+    s_counts.clear();
+
+    // 预算为0：被覆盖的READER（加载了4KB数据）被裁剪成状态包
+    pageManager.setRetentionBudget(0, 0);
+    CHECK(s_counts[PageType::READER].pause == 0);
+    CHECK(s_counts[PageType::READER].stop == 1);
+    CHECK(s_counts[PageType::READER].save == 1);
+    CHECK(s_counts[PageType::READER].destroy == 1);
+    CHECK(s_counts[PageType::DIALOG].pause == 0);
+    pageManager.setRetentionBudget(PageManager::DEFAULT_INTERNAL_BUDGET, PageManager::DEFAULT_PSRAM_BUDGET);
+}
+
+static void testLoadedDataCountsTowardBudget() {
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.startActivityClearTop(PageType::FILE_BROWSER);
+    pageManager.startActivity(PageType::DIALOG);
+
+    PageManager::RetentionStats stats = pageManager.getRetentionStats();
+    CHECK(stats.psramBytes >= LOADED_BYTES);
+
+    // 预算小于页面加载的数据时裁剪
+    uint32_t trims = stats.trims;
+    s_counts.clear();
+    pageManager.setRetentionBudget(PageManager::DEFAULT_INTERNAL_BUDGET, LOADED_BYTES / 2);
+    stats = pageManager.getRetentionStats();
+    CHECK(stats.trims == trims + 1);
+    CHECK(s_counts[PageType::FILE_BROWSER].destroy == 1);
+    CHECK(stats.psramBytes < LOADED_BYTES);
+    pageManager.setRetentionBudget(PageManager::DEFAULT_INTERNAL_BUDGET, PageManager::DEFAULT_PSRAM_BUDGET);
+}
+
+int main() {
+    PageManager& pageManager = PageManager::getInstance();
+    pageManager.setScreenSize(540, 960);
+    registerPages(pageManager);
+
+    testClearTopPausesOnce();
+    testTrimCoveredPage();
+    testLoadedDataCountsTowardBudget();
+
+    pageManager.destroy();
+    return finishTest("page_manager_test");
+}
@@ -0,0 +1,167 @@
+/**
+ * @brief 刷新策略测试（主机构建）
+ *
+ * 用合成的540x960 4bpp帧驱动RefreshPolicy::analyze/decide，检查选择的刷新模式和残影清理区域：
+ * - 灰阶区域
+ * - 页面切换（整屏变化）
+ * - 同一位置反复的小区域更新使瓦片残影超过阈值
+ */
+#include "check.h"
+#include "refresh_counter/RefreshPolicy.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const int16_t SCREEN_WIDTH = 540;
+static const int16_t SCREEN_HEIGHT = 960;
+static const size_t STRIDE = SCREEN_WIDTH / 2;
+
+/**
+ * @brief 4bpp帧（每字节两个像素，高半字节在前）
+ */
+struct Frame {
+    std::vector<uint8_t> pixels = std::vector<uint8_t>(STRIDE * SCREEN_HEIGHT, 0xFF);
+
+    void fill(const Rect& rect, uint8_t level) {
+        for (int16_t y = rect.y; y < rect.bottom(); y++) {
+            for (int16_t x = rect.x; x < rect.right(); x++) {
+                uint8_t& byte = pixels[y * STRIDE + x / 2];
+                byte = (x & 1) ? ((byte & 0xF0) | level) : ((byte & 0x0F) | (level << 4));
+            }
+        }
+    }
+};
+
+static const Rect SCREEN{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+
+static void initPolicy(RefreshMode preference) {
+    DeviceConfig config;
+    config.refreshMode = preference;
+    config.refreshInterval = 10;
+    RefreshPolicy::getInstance().init(config, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+/**
+ * @brief 统计一个区域的变化并交给策略决策
+ */
+static RefreshPolicy::Decision update(const Frame& before, const Frame& after, const Rect& rect) {
+    RegionChangeStats stats;
+    RefreshPolicy::analyze(before.pixels.data(), after.pixels.data(), STRIDE, rect, stats);
+    return RefreshPolicy::getInstance().decide(&stats, 1);
+}
+
+static Rect bounds(const DirtyRegion& region) {
+    Rect result;
+    bool first = true;
+    for (const Rect& rect : region) {
+        result = first ? rect : result.united(rect);
+        first = false;
+    }
+    return result;
+}
+
+static bool sameRect(const Rect& a, const Rect& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static void testGrayRegion() {
+    Frame white;
+    Frame gray;
+    Rect area{100, 200, 120, 90};
+    gray.fill(area, 8);
+
+    RegionChangeStats stats;
+    RefreshPolicy::analyze(white.pixels.data(), gray.pixels.data(), STRIDE, area, stats);
+    CHECK(stats.changedPixels == 120u * 90u);
+    CHECK(stats.grayPixels == 120u * 90u);
+    CHECK(stats.blackToWhite == 0u);
+
+    // 快速偏好下灰阶内容也要用文本模式，避免快刷把灰阶压成黑白
+    initPolicy(RefreshMode::Fast);
+    RefreshPolicy::Decision decision = RefreshPolicy::getInstance().decide(&stats, 1);
+    CHECK(decision.mode == RefreshPolicy::Mode::Text);
+    CHECK(decision.cleanRegion.isEmpty());
+    CHECK(RefreshPolicy::getInstance().ghostingAt(2, 4) > 0u);
+
+    // 高质量偏好下灰阶内容直接用高质量模式，并清除覆盖区域的残影
+    initPolicy(RefreshMode::Quality);
+    decision = RefreshPolicy::getInstance().decide(&stats, 1);
+    CHECK(decision.mode == RefreshPolicy::Mode::Quality);
+    CHECK(decision.cleanRegion.isEmpty());
+    CHECK(RefreshPolicy::getInstance().ghostingAt(2, 4) == 0u);
+}
+
+static void testPageFlip() {
+    Frame white;
+    Frame page;
+    page.fill(SCREEN, 0);
+
+    // 页面切换：变化超过半屏，整块瓦片记为需要清理，残影归零
+    initPolicy(RefreshMode::Fast);
+    RefreshPolicy::Decision decision = update(white, page, SCREEN);
+    CHECK(decision.mode == RefreshPolicy::Mode::Fast);
+    CHECK(!decision.cleanRegion.isEmpty());
+    CHECK(sameRect(bounds(decision.cleanRegion), SCREEN));
+    CHECK(RefreshPolicy::getInstance().ghostingAt(0, 0) == 0u);
+    CHECK(RefreshPolicy::getInstance().ghostingAt(8, 15) == 0u);
+
+    // 高质量偏好下黑白页面用文本模式显示，清理同样推迟到空闲时
+    initPolicy(RefreshMode::Quality);
+    decision = update(page, white, SCREEN);
+    CHECK(decision.mode == RefreshPolicy::Mode::Text);
+    CHECK(sameRect(bounds(decision.cleanRegion), SCREEN));
+}
+
+static void testRepeatedSmallUpdates() {
+    initPolicy(RefreshMode::Fast);
+    RefreshPolicy& policy = RefreshPolicy::getInstance();
+
+    // 在第一块瓦片内反复切换一小块区域（例如页码）
+    Rect spot{10, 10, 40, 20};
+    Rect tile{0, 0, RefreshPolicy::TILE_SIZE, RefreshPolicy::TILE_SIZE};
+    Frame frames[2];
+    frames[1].fill(spot, 0);
+
+    RefreshPolicy::Decision decision = update(frames[0], frames[1], spot);
+    CHECK(decision.mode == RefreshPolicy::Mode::Fastest);
+    CHECK(decision.cleanRegion.isEmpty());
+
+    // 由浅变深用最快模式，由深变浅的比例高，改用快速模式
+    decision = update(frames[1], frames[0], spot);
+    CHECK(decision.mode == RefreshPolicy::Mode::Fast);
+
+    int updates = 2;
+    uint32_t previousGhost = policy.ghostingAt(0, 0);
+    CHECK(previousGhost > 0u);
+    bool cleaned = false;
+    while (updates < 200 && !cleaned) {
+        const Frame& before = frames[updates % 2];
+        const Frame& after = frames[(updates + 1) % 2];
+        decision = update(before, after, spot);
+        updates++;
+        if (decision.cleanRegion.isEmpty()) {
+            // 阈值之前残影只增不减，相邻瓦片不受影响
+            CHECK(policy.ghostingAt(0, 0) > previousGhost);
+            CHECK(policy.ghostingAt(0, 0) < policy.getCleanThreshold());
+            CHECK(policy.ghostingAt(1, 0) == 0u);
+            previousGhost = policy.ghostingAt(0, 0);
+            continue;
+        }
+        cleaned = true;
+        // 只清理超过阈值的那块瓦片
+        CHECK(decision.cleanRegion.size() == 1u);
+        CHECK(sameRect(bounds(decision.cleanRegion), tile));
+        CHECK(policy.ghostingAt(0, 0) == 0u);
+    }
+    CHECK(cleaned);
+    CHECK(updates > 2);
+    printf("[INFO] tile cleaned after %d small updates (threshold %u)\n", updates,
+           (unsigned)policy.getCleanThreshold());
+}
+
+int main() {
+    testGrayRegion();
+    testPageFlip();
+    testRepeatedSmallUpdates();
+    return finishTest("refresh_policy_test");
+}
@@ -0,0 +1,264 @@
+#include "UiBenchmark.h"
+
+#if UI_BENCHMARK_ENABLED
+
+#include "page_manager/PageManager.h"
+#include "jobs/JobScheduler.h"
+#include "render/FrameBufferSurface.h"
+#include "ui_kit/PagedListView.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+static const char* TAG = "UiBenchmark";
+
+// 等待页面异步加载完成的最长时间
+static const uint32_t LOAD_TIMEOUT_MS = 10000;
+
+static std::atomic<uint32_t> s_allocationCount{0};
+
+// 基准测试构建中替换全局operator new以统计分配次数
+void* operator new(size_t size) {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        abort();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+uint32_t UiBenchmark::allocationCount() {
+    return s_allocationCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 单个阶段的采样结果
+ */
+struct PhaseSamples {
+    std::vector<uint32_t> micros;  ///< 每次迭代的耗时（微秒）
+    uint32_t allocations = 0;      ///< 所有迭代的分配次数合计
+
+    uint32_t percentile(int p) const {
+        if (micros.empty()) {
+            return 0;
+        }
+        std::vector<uint32_t> sorted(micros);
+        std::sort(sorted.begin(), sorted.end());
+        size_t index = (sorted.size() - 1) * p / 100;
+        return sorted[index];
+    }
+};
+
+/**
+ * @brief 计时并统计分配次数
+ */
+template <typename Fn>
+static void sample(PhaseSamples& phase, Fn&& fn) {
+    uint32_t allocationsBefore = UiBenchmark::allocationCount();
+    int64_t start = esp_timer_get_time();
+    fn();
+    int64_t elapsed = esp_timer_get_time() - start;
+    phase.allocations += UiBenchmark::allocationCount() - allocationsBefore;
+    phase.micros.push_back(static_cast<uint32_t>(elapsed));
+}
+
+static void appendPhase(std::string& json, const char* name, const PhaseSamples& phase, int iterations, bool last) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "\"%s\":{\"p50_us\":%u,\"p99_us\":%u,\"allocs_per_iter\":%.2f}%s",
+             name, (unsigned)phase.percentile(50), (unsigned)phase.percentile(99),
+             iterations > 0 ? static_cast<double>(phase.allocations) / iterations : 0.0, last ? "" : ",");
+    json += buffer;
+}
+
+static bool benchmarkPage(PageType pageType, std::shared_ptr<void> params, FrameBufferSurface& surface, int iterations) {
+    PageManager& pageManager = PageManager::getInstance();
+    std::unique_ptr<Page> page = pageManager.createPage(pageType);
+    if (!page) {
+        ESP_LOGW(TAG, "Page type %d is not registered", static_cast<int>(pageType));
+        return false;
+    }
+
+    PhaseSamples create;
+    PhaseSamples load;
+    PhaseSamples measure;
+    PhaseSamples layout;
+    PhaseSamples draw;
+    PhaseSamples dirtyCheck;
+
+    page->setParams(params);
+    sample(create, [&]() {
+        page->onCreate();
+        page->onStart();
+        page->onResume();
+    });
+
+    // 页面内容可能由后台任务异步加载（文件浏览器的目录列表），
+    // 等任务结束并执行完成回调后再采样，否则测到的只是加载占位视图
+    bool loaded = true;
+    sample(load, [&]() { loaded = JobScheduler::getInstance().runUntilIdle(pdMS_TO_TICKS(LOAD_TIMEOUT_MS)); });
+    if (!loaded) {
+        ESP_LOGW(TAG, "Page %s is still loading after %u ms", page->getName().c_str(), (unsigned)LOAD_TIMEOUT_MS);
+    }
+
+    View* root = page->getRootView();
+    if (root == nullptr) {
+        ESP_LOGW(TAG, "Page %s has no root view", page->getName().c_str());
+    } else {
+        int16_t width = surface.width();
+        int16_t height = surface.height();
+        for (int i = 0; i < iterations; i++) {
+            // 每次迭代都强制完整的测量、布局和重绘
+            root->requestLayout();
+            sample(measure, [&]() { root->measure(surface, width, height); });
+            sample(layout, [&]() { root->layout(0, 0, width, height); });
+            root->forceRedraw();
+            sample(draw, [&]() { root->draw(surface); });
+            sample(dirtyCheck, [&]() { (void)page->isDirty(); });
+        }
+    }
+
+    std::string json = "{\"page\":\"" + page->getName() + "\",\"iterations\":" + std::to_string(iterations) + ",";
+    appendPhase(json, "create", create, 1, false);
+    appendPhase(json, "load", load, 1, false);
+    appendPhase(json, "measure", measure, iterations, false);
+    appendPhase(json, "layout", layout, iterations, false);
+    appendPhase(json, "draw", draw, iterations, false);
+    appendPhase(json, "dirty_check", dirtyCheck, iterations, true);
+    json += "}";
+    printf("UI_BENCHMARK %s\n", json.c_str());
+
+    page->onPause();
+    page->onStop();
+    page->onDestroy();
+    return loaded && root != nullptr;
+}
+
+/**
+ * @brief 比较std::function和InlineFunction作为项目渲染器的开销
+ *
+ * 每次迭代先像setItemRenderer那样安装一次渲染器，再按列表绘制的方式连续调用
+ * RENDER_CALLS次；渲染器只做简单计算，不绘制，使结果只反映回调本身的开销。
+ * 捕获内容与页面中的常见写法相当（几个指针），超过std::function的内联存储。
+ */
+static void benchmarkItemRenderer(FrameBufferSurface& surface, int iterations) {
+    static const int RENDER_CALLS = 1000;
+    typedef std::function<void(DrawSurface& display, int index, const char* item,
+                               int16_t x, int16_t y, int16_t width, int16_t height)> StdRenderer;
+
+    volatile uint32_t sink = 0;
+    uint32_t drawn = 0;
+    const char* item = "benchmark.txt";
+    PhaseSamples stdInstall;
+    PhaseSamples stdInvoke;
+    PhaseSamples inlineInstall;
+    PhaseSamples inlineInvoke;
+
+    for (int i = 0; i < iterations; i++) {
+        StdRenderer stdRenderer;
+        sample(stdInstall, [&]() {
+            stdRenderer = [&sink, &drawn, item](DrawSurface&, int index, const char* text,
+                                                 int16_t x, int16_t y, int16_t, int16_t) {
+                sink = sink + index + x + y + static_cast<uint8_t>(text[0]) + item[1];
+                drawn++;
+            };
+        });
+        sample(stdInvoke, [&]() {
+            for (int n = 0; n < RENDER_CALLS; n++) {
+                stdRenderer(surface, n, item, 0, static_cast<int16_t>(n), 100, 20);
+            }
+        });
+
+        PagedListView::ItemRenderer inlineRenderer;
+        sample(inlineInstall, [&]() {
+            inlineRenderer = [&sink, &drawn, item](DrawSurface&, int index, const char* text,
+                                                    int16_t x, int16_t y, int16_t, int16_t) {
+                sink = sink + index + x + y + static_cast<uint8_t>(text[0]) + item[1];
+                drawn++;
+            };
+        });
+        sample(inlineInvoke, [&]() {
+            for (int n = 0; n < RENDER_CALLS; n++) {
+                inlineRenderer(surface, n, item, 0, static_cast<int16_t>(n), 100, 20);
+            }
+        });
+    }
+
+    std::string json = "{\"page\":\"item_renderer_callback\",\"iterations\":" + std::to_string(iterations) +
+                       ",\"calls_per_iter\":" + std::to_string(RENDER_CALLS) + ",";
+    appendPhase(json, "std_function_install", stdInstall, iterations, false);
+    appendPhase(json, "std_function_invoke", stdInvoke, iterations, false);
+    appendPhase(json, "inline_function_install", inlineInstall, iterations, false);
+    appendPhase(json, "inline_function_invoke", inlineInvoke, iterations, true);
+    json += "}";
+    printf("UI_BENCHMARK %s\n", json.c_str());
+    ESP_LOGD(TAG, "Item renderer calls: %u", (unsigned)drawn);
+}
+
+bool UiBenchmark::run(DrawSurface& display, int iterations) {
+    FrameBufferSurface surface;
+    if (!surface.create(display.width(), display.height(), true, display.getFont())) {
+        ESP_LOGE(TAG, "Failed to allocate the benchmark surface");
+        return false;
+    }
+    ESP_LOGI(TAG, "Running UI benchmark: %d iterations on %dx%d", iterations, (int)surface.width(), (int)surface.height());
+
+    bool ok = benchmarkPage(PageType::MENU, nullptr, surface, iterations);
+    ok = benchmarkPage(PageType::SETTINGS, nullptr, surface, iterations) && ok;
+    ok = benchmarkPage(PageType::FILE_BROWSER, nullptr, surface, iterations) && ok;
+    ok = benchmarkPage(PageType::MESSAGE, std::make_shared<std::string>("基准测试消息 Benchmark message"), surface,
+                       iterations) && ok;
+    benchmarkItemRenderer(surface, iterations);
+
+    ESP_LOGI(TAG, "UI benchmark finished");
+    return ok;
+}
+
+#else
+
+bool UiBenchmark::run(DrawSurface& display, int iterations) {
+    (void)display;
+    (void)iterations;
+    return false;
+}
+
+uint32_t UiBenchmark::allocationCount() {
+    return 0;
+}
+
+#endif
\ No newline at end of file
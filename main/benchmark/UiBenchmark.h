@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "ui_kit/DrawSurface.h"
+
+// 默认不编译基准测试，需要时在main/CMakeLists.txt中定义UI_BENCHMARK_ENABLED=1
+#ifndef UI_BENCHMARK_ENABLED
+#define UI_BENCHMARK_ENABLED 0
+#endif
+
+/**
+ * @brief UI渲染基准测试
+ * 
+ * 依次创建已注册的页面（启动器、设置、分页文件浏览器、消息），等待页面的后台加载任务完成后，
+ * 在内存帧缓冲上反复执行measure/layout/draw和脏检查，
+ * 使用esp_timer统计每个阶段的p50/p99耗时和堆分配次数，并以JSON格式输出到控制台。
+ * 最后比较项目渲染器回调使用std::function和InlineFunction的开销。
+ * 每个页面（以及回调比较）输出一行，以"UI_BENCHMARK "开头，便于脚本提取。
+ * 设备上在UI任务启动前由app_main调用，主机上由host/bench/ui_benchmark.cpp调用。
+ */
+class UiBenchmark {
+public:
+    static const int DEFAULT_ITERATIONS = 50;  ///< 默认迭代次数
+
+    /**
+     * @brief 运行所有页面的基准测试
+     * @param display 提供尺寸和字体的显示对象（设备上为M5.Display，主机上为内存帧缓冲）
+     * @param iterations 每个页面的迭代次数
+     * @return 所有页面都创建并加载完成时返回true；页面未注册、没有根视图或加载超时时返回false
+     */
+    static bool run(DrawSurface& display, int iterations = DEFAULT_ITERATIONS);
+
+    /**
+     * @brief 获取累计的堆分配次数（仅在UI_BENCHMARK_ENABLED时统计）
+     * @return 分配次数
+     */
+    static uint32_t allocationCount();
+};
\ No newline at end of file
@@ -41,6 +41,20 @@ enum FontSize {
     Large = 2, 
 };
 
+/**
+ * UI循环模式
+ */
+enum UiLoopMode {
+    /**
+     * 事件驱动，空闲时自动浅睡眠
+     */
+    EventDriven = 0,
+    /**
+     * 每10ms轮询一次
+     */
+    Polling,
+};
+
 /**
  * 设备配置结构体
  */
@@ -50,5 +64,7 @@ struct DeviceConfig {
     uint8_t refreshInterval = 10;    // 自动刷新间隔（秒）
     char* fontPath;           // 字体文件路径  
     RefreshMode refreshMode = RefreshMode::Quality; // 刷新模式
+    uint8_t idleRefreshDelay = 3;    // 无操作多久后清理残影（秒）
     FontSize fontSize = FontSize::Meium; // 字体大小
+    UiLoopMode uiLoopMode = UiLoopMode::EventDriven; // UI循环模式
 };
\ No newline at end of file
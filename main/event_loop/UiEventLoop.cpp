@@ -0,0 +1,218 @@
+#include "UiEventLoop.h"
+#include "M5Unified.h"
+#include "esp_log.h"
+#include "esp_sleep.h"
+#include "../ui_kit/ViewGroup.h"
+#include "../jobs/JobScheduler.h"
+
+static const char* TAG = "UiEventLoop";
+
+static const UBaseType_t EVENT_QUEUE_LENGTH = 16;
+
+UiEventLoop& UiEventLoop::getInstance() {
+    static UiEventLoop instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+bool UiEventLoop::init(UiLoopMode mode) {
+    _mode = UiLoopMode::Polling;
+    _lastWakeUs = esp_timer_get_time();
+    _lastStatsLogUs = _lastWakeUs;
+    if (mode == UiLoopMode::Polling) {
+        ESP_LOGI(TAG, "UI loop in polling mode (%u ms)", (unsigned)POLL_INTERVAL_MS);
+        return true;
+    }
+
+    _queue = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(Event));
+    if (_queue == nullptr) {
+        ESP_LOGE(TAG, "Failed to create event queue, falling back to polling");
+        return false;
+    }
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &UiEventLoop::timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "ui_timer";
+    if (esp_timer_create(&timerArgs, &_timer) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to create UI timer");
+        _timer = nullptr;
+    }
+
+    setupTouchInterrupt();
+    setupLightSleep();
+
+    // 视图树产生脏区域时唤醒UI循环（包括其他任务中的修改）
+    ViewGroup::setRootInvalidateHook([]() { UiEventLoop::getInstance().requestRedraw(); });
+    // 后台任务完成后唤醒UI循环执行回调
+    JobScheduler::setWakeHook([]() { UiEventLoop::getInstance().post(EventType::WORK_DONE); });
+
+    _mode = UiLoopMode::EventDriven;
+    ESP_LOGI(TAG, "UI loop is event driven (touch interrupt: %s)", _touchInterruptReady ? "yes" : "no");
+    return true;
+}
+
+void UiEventLoop::setupTouchInterrupt() {
+    gpio_set_direction(TOUCH_INT_GPIO, GPIO_MODE_INPUT);
+    gpio_set_pull_mode(TOUCH_INT_GPIO, GPIO_PULLUP_ONLY);
+
+    // 使用低电平触发，这样同一个引脚也能作为浅睡眠的唤醒源；
+    // 中断触发后先关闭，由UI任务在重新阻塞前打开
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(err));
+        return;
+    }
+    gpio_set_intr_type(TOUCH_INT_GPIO, GPIO_INTR_LOW_LEVEL);
+    if (gpio_isr_handler_add(TOUCH_INT_GPIO, &UiEventLoop::touchIsrHandler, this) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to add touch ISR handler");
+        return;
+    }
+    gpio_wakeup_enable(TOUCH_INT_GPIO, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    _touchInterruptReady = true;
+}
+
+void UiEventLoop::setupLightSleep() {
+    // CONFIG_PM_ENABLE和CONFIG_FREERTOS_USE_TICKLESS_IDLE在sdkconfig.defaults中开启
+    esp_pm_config_t pmConfig = {};
+    pmConfig.max_freq_mhz = 240;
+    pmConfig.min_freq_mhz = 80;
+    pmConfig.light_sleep_enable = true;
+    esp_err_t err = esp_pm_configure(&pmConfig);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Automatic light sleep unavailable: %s (check CONFIG_PM_ENABLE in sdkconfig)",
+                 esp_err_to_name(err));
+        return;
+    }
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "epd_refresh", &_displayLock) != ESP_OK) {
+        _displayLock = nullptr;
+    }
+}
+
+void UiEventLoop::touchIsrHandler(void* arg) {
+    UiEventLoop* self = static_cast<UiEventLoop*>(arg);
+    gpio_intr_disable(TOUCH_INT_GPIO);
+    Event event = {EventType::TOUCH, 0};
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xQueueSendFromISR(self->_queue, &event, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+void UiEventLoop::timerCallback(void* arg) {
+    UiEventLoop* self = static_cast<UiEventLoop*>(arg);
+    self->post(EventType::TIMER, self->_timerArg);
+}
+
+void UiEventLoop::post(EventType type, uint32_t arg) {
+    if (_mode != UiLoopMode::EventDriven) {
+        return;
+    }
+    Event event = {type, arg};
+    if (xQueueSend(_queue, &event, 0) != pdTRUE) {
+        // 队列已满说明UI任务马上就会被唤醒，丢弃即可
+        ESP_LOGV(TAG, "Event queue full, dropping event %d", static_cast<int>(type));
+    }
+}
+
+void UiEventLoop::requestRedraw() {
+    if (_mode != UiLoopMode::EventDriven) {
+        return;
+    }
+    if (!_redrawPending.exchange(true)) {
+        post(EventType::INVALIDATE);
+    }
+}
+
+bool UiEventLoop::scheduleTimer(uint32_t delayMs, uint32_t arg) {
+    if (_timer == nullptr) {
+        return false;
+    }
+    if (esp_timer_is_active(_timer)) {
+        esp_timer_stop(_timer);
+    }
+    _timerArg = arg;
+    return esp_timer_start_once(_timer, static_cast<uint64_t>(delayMs) * 1000) == ESP_OK;
+}
+
+void UiEventLoop::onDisplayPushed() {
+    if (_displayLock != nullptr && !_displayLockHeld) {
+        esp_pm_lock_acquire(_displayLock);
+        _displayLockHeld = true;
+    }
+}
+
+void UiEventLoop::countEvent(const Event& event) {
+    switch (event.type) {
+        case EventType::TOUCH:
+            _stats.touchEvents++;
+            break;
+        case EventType::INVALIDATE:
+            _stats.invalidateEvents++;
+            break;
+        case EventType::TIMER:
+            _stats.timerEvents++;
+            break;
+        case EventType::DISPLAY_DONE:
+            _stats.displayEvents++;
+            break;
+        case EventType::WORK_DONE:
+            _stats.workEvents++;
+            break;
+    }
+}
+
+void UiEventLoop::waitForEvent(bool touchActive) {
+    int64_t blockStart = esp_timer_get_time();
+    _stats.activeUs += blockStart - _lastWakeUs;
+
+    if (_mode == UiLoopMode::Polling) {
+        lgfx::v1::delay(POLL_INTERVAL_MS);
+    } else {
+        // 墨水屏刷新完成后才允许浅睡眠
+        if (_displayLockHeld && !M5.Display.displayBusy()) {
+            esp_pm_lock_release(_displayLock);
+            _displayLockHeld = false;
+        }
+        TickType_t timeout = portMAX_DELAY;
+        if (touchActive) {
+            // 跟踪手势时需要连续采样触摸坐标
+            timeout = pdMS_TO_TICKS(POLL_INTERVAL_MS);
+        } else {
+            if (_displayLockHeld) {
+                timeout = pdMS_TO_TICKS(DISPLAY_POLL_MS);
+            }
+            if (_touchInterruptReady) {
+                gpio_intr_enable(TOUCH_INT_GPIO);
+            }
+        }
+
+        Event event;
+        if (xQueueReceive(_queue, &event, timeout) == pdTRUE) {
+            countEvent(event);
+            // 合并已经排队的事件，一次唤醒处理完
+            while (xQueueReceive(_queue, &event, 0) == pdTRUE) {
+                countEvent(event);
+            }
+        }
+        _redrawPending = false;
+    }
+
+    _lastWakeUs = esp_timer_get_time();
+    _stats.idleUs += _lastWakeUs - blockStart;
+    _stats.wakeups++;
+    if (_lastWakeUs - _lastStatsLogUs >= STATS_LOG_INTERVAL_US) {
+        logStats(_lastWakeUs);
+    }
+}
+
+void UiEventLoop::logStats(int64_t now) {
+    int64_t total = _stats.activeUs + _stats.idleUs;
+    ESP_LOGI(TAG, "%s: %u wakeups (touch %u, redraw %u, timer %u, display %u, work %u), UI task active %lld ms / %lld ms (%.2f%%)",
+             _mode == UiLoopMode::EventDriven ? "event driven" : "polling",
+             (unsigned)_stats.wakeups, (unsigned)_stats.touchEvents, (unsigned)_stats.invalidateEvents,
+             (unsigned)_stats.timerEvents, (unsigned)_stats.displayEvents, (unsigned)_stats.workEvents, (long long)(_stats.activeUs / 1000), (long long)(total / 1000),
+             total > 0 ? 100.0 * _stats.activeUs / total : 0.0);
+    _stats = Stats();
+    _lastStatsLogUs = now;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
+#include "../config/DeviceConfig.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief UI事件循环 - 让UI任务在没有事件时阻塞
+ * 
+ * 单例模式。UI任务阻塞在FreeRTOS队列上，由触摸中断、定时器和视图的markDirty唤醒；
+ * 配置了电源管理（CONFIG_PM_ENABLE + 无滴答空闲）时，阻塞期间系统自动进入浅睡眠。
+ * 手指在屏幕上或墨水屏正在刷新时改为短间隔轮询。
+ * 轮询模式保留原来每10ms检查一次的行为，用于对比耗电。
+ */
+class UiEventLoop {
+public:
+    static const gpio_num_t TOUCH_INT_GPIO = GPIO_NUM_48;  ///< M5PaperS3触摸芯片（GT911）中断引脚
+    static const uint32_t POLL_INTERVAL_MS = 10;           ///< 轮询模式及触摸跟踪时的间隔
+    static const uint32_t DISPLAY_POLL_MS = 20;            ///< 等待墨水屏刷新完成的轮询间隔
+    static const int64_t STATS_LOG_INTERVAL_US = 60 * 1000 * 1000;  ///< 统计信息输出间隔
+
+    /**
+     * @brief 事件类型
+     */
+    enum class EventType : uint8_t {
+        TOUCH,       ///< 触摸中断
+        INVALIDATE,  ///< 视图需要重绘
+        TIMER,       ///< 定时器到期
+        DISPLAY_DONE, ///< 面板刷新完成
+        WORK_DONE    ///< 后台工作完成，结果等待UI任务处理
+    };
+
+    /**
+     * @brief 事件
+     */
+    struct Event {
+        EventType type;  ///< 事件类型
+        uint32_t arg;    ///< 附加参数
+    };
+
+    /**
+     * @brief 运行统计，用于比较两种模式的唤醒次数和CPU占用
+     */
+    struct Stats {
+        uint32_t wakeups = 0;           ///< 唤醒次数
+        uint32_t touchEvents = 0;       ///< 触摸事件数
+        uint32_t invalidateEvents = 0;  ///< 重绘事件数
+        uint32_t timerEvents = 0;       ///< 定时器事件数
+        uint32_t displayEvents = 0;     ///< 刷新完成事件数
+        uint32_t workEvents = 0;        ///< 后台工作完成事件数
+        int64_t activeUs = 0;           ///< UI任务处理事件的累计时间
+        int64_t idleUs = 0;             ///< UI任务阻塞的累计时间
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return UiEventLoop单例实例引用
+     */
+    static UiEventLoop& getInstance();
+
+    /**
+     * @brief 初始化事件循环（需要在M5.begin之后调用）
+     * @param mode 循环模式
+     * @return 初始化成功返回true，失败时退回轮询模式并返回false
+     */
+    bool init(UiLoopMode mode);
+
+    /**
+     * @brief 获取当前循环模式
+     * @return 循环模式
+     */
+    UiLoopMode getMode() const { return _mode; }
+
+    /**
+     * @brief 投递事件（任意任务中调用，不阻塞）
+     * @param type 事件类型
+     * @param arg 附加参数
+     */
+    void post(EventType type, uint32_t arg = 0);
+
+    /**
+     * @brief 请求重绘，未处理的重绘请求会被合并
+     */
+    void requestRedraw();
+
+    /**
+     * @brief 在指定时间后投递定时器事件（重新调用会替换之前的定时器）
+     * @param delayMs 延迟（毫秒）
+     * @param arg 附加参数
+     * @return 成功返回true，否则返回false
+     */
+    bool scheduleTimer(uint32_t delayMs, uint32_t arg = 0);
+
+    /**
+     * @brief 等待下一个事件
+     * @param touchActive 手指是否仍在屏幕上（此时按轮询间隔返回）
+     */
+    void waitForEvent(bool touchActive);
+
+    /**
+     * @brief 通知已经把内容推送到墨水屏，刷新完成前禁止浅睡眠
+     */
+    void onDisplayPushed();
+
+    /**
+     * @brief 获取运行统计
+     * @return 统计信息
+     */
+    Stats getStats() const { return _stats; }
+
+private:
+    UiEventLoop() = default;
+    ~UiEventLoop() = default;
+    UiEventLoop(const UiEventLoop&) = delete;
+    UiEventLoop& operator=(const UiEventLoop&) = delete;
+
+    static void touchIsrHandler(void* arg);
+    static void timerCallback(void* arg);
+
+    void setupTouchInterrupt();
+    void setupLightSleep();
+    void countEvent(const Event& event);
+    void logStats(int64_t now);
+
+    UiLoopMode _mode = UiLoopMode::Polling;      ///< 循环模式
+    QueueHandle_t _queue = nullptr;              ///< 事件队列
+    esp_timer_handle_t _timer = nullptr;         ///< 定时器
+    uint32_t _timerArg = 0;                      ///< 定时器事件参数
+    esp_pm_lock_handle_t _displayLock = nullptr; ///< 墨水屏刷新期间的禁止浅睡眠锁
+    bool _displayLockHeld = false;               ///< 是否持有禁止浅睡眠锁
+    bool _touchInterruptReady = false;           ///< 触摸中断是否可用
+    std::atomic<bool> _redrawPending{false};     ///< 是否已有未处理的重绘事件
+    Stats _stats;                                ///< 运行统计
+    int64_t _lastWakeUs = 0;                     ///< 上次被唤醒的时间
+    int64_t _lastStatsLogUs = 0;                 ///< 上次输出统计信息的时间
+};
\ No newline at end of file
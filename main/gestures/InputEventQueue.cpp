@@ -0,0 +1,33 @@
+#include "InputEventQueue.h"
+#include "esp_log.h"
+
+static const char* TAG = "InputEventQueue";
+
+bool InputEventQueue::push(const InputEvent& event) {
+    if (_count > 0 && event.type == InputEvent::Type::SWIPE) {
+        InputEvent& tail = _events[(_head + _count - 1) % CAPACITY];
+        if (tail.type == InputEvent::Type::SWIPE && tail.direction == event.direction && tail.count < UINT16_MAX) {
+            tail.count += event.count;
+            ESP_LOGD(TAG, "Coalesced swipe %d, count %u", static_cast<int>(event.direction), (unsigned)tail.count);
+            return true;
+        }
+    }
+
+    if (_count >= CAPACITY) {
+        ESP_LOGW(TAG, "Input queue full, dropping event");
+        return false;
+    }
+    _events[(_head + _count) % CAPACITY] = event;
+    _count++;
+    return true;
+}
+
+bool InputEventQueue::pop(InputEvent& event) {
+    if (_count == 0) {
+        return false;
+    }
+    event = _events[_head];
+    _head = (_head + 1) % CAPACITY;
+    _count--;
+    return true;
+}
\ No newline at end of file
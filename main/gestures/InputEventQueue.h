@@ -0,0 +1,91 @@
+#pragma once
+
+#include "TouchGestureDetector.h"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief 输入事件
+ */
+struct InputEvent {
+    /**
+     * @brief 输入事件类型
+     */
+    enum class Type : uint8_t {
+        TAP,    ///< 点击
+        SWIPE   ///< 滑动
+    };
+
+    Type type = Type::TAP;  ///< 事件类型
+    TouchGestureDetector::SwipeDirection direction = TouchGestureDetector::SwipeDirection::NONE;  ///< 滑动方向
+    int16_t x = 0;          ///< 点击X坐标
+    int16_t y = 0;          ///< 点击Y坐标
+    uint16_t count = 1;     ///< 合并的连续同向滑动次数
+
+    /**
+     * @brief 创建点击事件
+     */
+    static InputEvent tap(int16_t x, int16_t y) {
+        InputEvent event;
+        event.type = Type::TAP;
+        event.x = x;
+        event.y = y;
+        return event;
+    }
+
+    /**
+     * @brief 创建滑动事件
+     */
+    static InputEvent swipe(TouchGestureDetector::SwipeDirection direction) {
+        InputEvent event;
+        event.type = Type::SWIPE;
+        event.direction = direction;
+        return event;
+    }
+};
+
+/**
+ * @brief 输入事件队列 - 面板刷新期间暂存并合并输入
+ * 
+ * 固定容量的先进先出队列。与队尾同方向的滑动会合并为一个事件并累加次数，
+ * 例如刷新期间连续三次翻页只会分发一次"前进三页"，只绘制最终状态。
+ * 点击不合并，并保持与滑动的先后顺序。
+ */
+class InputEventQueue {
+public:
+    static const size_t CAPACITY = 8;  ///< 队列容量
+
+    /**
+     * @brief 加入事件，能合并时与队尾事件合并
+     * @param event 输入事件
+     * @return 成功返回true，队列已满时丢弃并返回false
+     */
+    bool push(const InputEvent& event);
+
+    /**
+     * @brief 取出队首事件
+     * @param event 输出的事件
+     * @return 队列非空返回true
+     */
+    bool pop(InputEvent& event);
+
+    /**
+     * @brief 是否为空
+     */
+    bool isEmpty() const { return _count == 0; }
+
+    /**
+     * @brief 获取事件数量
+     */
+    size_t size() const { return _count; }
+
+    /**
+     * @brief 清空队列
+     */
+    void clear() { _head = 0; _count = 0; }
+
+private:
+    InputEvent _events[CAPACITY];  ///< 环形缓冲区
+    size_t _head = 0;              ///< 队首下标
+    size_t _count = 0;             ///< 事件数量
+};
\ No newline at end of file
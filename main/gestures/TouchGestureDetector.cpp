@@ -1,4 +1,5 @@
 #include "TouchGestureDetector.h"
+#include <M5Unified.h>
 #include <cmath>
 #include "esp_timer.h"
 
@@ -1,8 +1,12 @@
 #pragma once
 
-#include <M5Unified.h>
+#include <cstdint>
 #include "esp_log.h"
 
+namespace m5 {
+struct touch_detail_t;
+}
+
 /**
  * @brief 触摸手势检测器 - 用于检测滑动手势
  * 
@@ -38,6 +42,12 @@ public:
      */
     void reset();
 
+    /**
+     * @brief 是否正在跟踪一次触摸
+     * @return 手指仍在屏幕上时返回true
+     */
+    bool isTouching() const { return _isTouching; }
+
 private:
     bool _isTouching;                    ///< 是否正在触摸
     uint32_t _touchStartTime;           ///< 触摸开始时间
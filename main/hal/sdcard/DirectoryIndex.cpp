@@ -0,0 +1,157 @@
+#include "DirectoryIndex.h"
+#include "sdcard.h"
+#include "esp_log.h"
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+static const char* TAG = "DirectoryIndex";
+
+// 索引文件统一存放的目录
+#define INDEX_DIR SDCARD_MOUNT_POINT "/.index"
+
+// 目录项按原样写入文件，布局变化时需要提升VERSION
+static_assert(sizeof(DirectoryEntry) == 16, "DirectoryEntry layout changed, bump DirectoryIndex::VERSION");
+
+std::string DirectoryIndex::indexPathFor(const char* path, const char* suffix) {
+    // FNV-1a哈希目录路径作为文件名，路径本身保存在文件头之后用于校验
+    uint32_t hash = 2166136261u;
+    for (const char* p = path; *p; p++) {
+        hash ^= static_cast<uint8_t>(*p);
+        hash *= 16777619u;
+    }
+    char name[sizeof(INDEX_DIR) + 24];
+    snprintf(name, sizeof(name), INDEX_DIR "/%08lx%s", (unsigned long)hash, suffix);
+    return name;
+}
+
+uint32_t DirectoryIndex::directoryMtime(const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(st.st_mtime);
+}
+
+DirectoryIndex::LoadResult DirectoryIndex::load(const char* path, DirectoryListing& listing, uint32_t filterTag) {
+    std::string indexPath = indexPathFor(path, ".idx");
+    FILE* file = fopen(indexPath.c_str(), "rb");
+    if (file == nullptr) {
+        return MISSING;
+    }
+
+    Header header;
+    size_t pathLength = strlen(path);
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == MAGIC && header.version == VERSION &&
+              header.filterTag == filterTag && header.pathLength == pathLength &&
+              header.entryCount <= MAX_ENTRIES && header.namesSize <= MAX_NAMES_SIZE;
+
+    // 哈希可能冲突，比较保存的目录路径
+    std::string storedPath;
+    if (ok) {
+        storedPath.resize(pathLength);
+        ok = fread(&storedPath[0], 1, pathLength, file) == pathLength && storedPath == path;
+    }
+
+    if (ok) {
+        listing.reset(storedPath);
+        listing._entries.resize(header.entryCount);
+        listing._names.resize(header.namesSize);
+        ok = fread(listing._entries.data(), sizeof(DirectoryEntry), header.entryCount, file) == header.entryCount &&
+             fread(listing._names.data(), 1, header.namesSize, file) == header.namesSize;
+    }
+    fclose(file);
+
+    // 名称必须落在名称池内并以'\0'结尾
+    for (size_t i = 0; ok && i < listing._entries.size(); i++) {
+        const DirectoryEntry& entry = listing._entries[i];
+        ok = (size_t)entry.nameOffset + entry.nameLength < listing._names.size() &&
+             listing._names[entry.nameOffset + entry.nameLength] == '\0';
+    }
+
+    if (!ok) {
+        ESP_LOGW(TAG, "Discarding invalid index for %s", path);
+        listing.reset(path);
+        remove(indexPath.c_str());
+        return MISSING;
+    }
+
+    if (header.dirMtime != directoryMtime(path)) {
+        ESP_LOGD(TAG, "Index for %s is stale", path);
+        return STALE;
+    }
+    ESP_LOGD(TAG, "Loaded index for %s: %u entries", path, (unsigned)listing.size());
+    return VALID;
+}
+
+bool DirectoryIndex::save(const DirectoryListing& listing, uint32_t filterTag) {
+    const std::string& path = listing.path();
+    if (path.size() > UINT16_MAX) {
+        return false;
+    }
+    if (mkdir(INDEX_DIR, 0775) != 0 && errno != EEXIST) {
+        ESP_LOGW(TAG, "Failed to create %s: errno %d", INDEX_DIR, errno);
+        return false;
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.pathLength = static_cast<uint16_t>(path.size());
+    header.filterTag = filterTag;
+    header.dirMtime = directoryMtime(path.c_str());
+    header.entryCount = static_cast<uint32_t>(listing._entries.size());
+    header.namesSize = static_cast<uint32_t>(listing._names.size());
+
+    // 先写临时文件，写入中断时旧索引仍然完整
+    std::string tempPath = indexPathFor(path.c_str(), ".tmp");
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        ESP_LOGW(TAG, "Failed to create %s", tempPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(path.data(), 1, path.size(), file) == path.size() &&
+              fwrite(listing._entries.data(), sizeof(DirectoryEntry), header.entryCount, file) == header.entryCount &&
+              fwrite(listing._names.data(), 1, header.namesSize, file) == header.namesSize;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        ESP_LOGW(TAG, "Failed to write index for %s", path.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    // FAT上rename不会覆盖已有文件
+    std::string indexPath = indexPathFor(path.c_str(), ".idx");
+    remove(indexPath.c_str());
+    if (rename(tempPath.c_str(), indexPath.c_str()) != 0) {
+        ESP_LOGW(TAG, "Failed to replace index for %s", path.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+    ESP_LOGD(TAG, "Saved index for %s: %u entries", path.c_str(), (unsigned)header.entryCount);
+    return true;
+}
+
+bool DirectoryIndex::refresh(const char* path, DirectoryListing& listing, DirectoryScanner::Filter filter,
+                             uint8_t options, uint32_t filterTag, bool stale,
+                             const std::function<bool()>& cancelled) {
+    DirectoryListing fresh;
+    if (!DirectoryScanner::scan(path, fresh, filter, options, cancelled, &listing)) {
+        return false;
+    }
+    if (fresh.sameEntries(listing)) {
+        // 内容没变但目录时间变了，重写索引记录新时间，避免下次再判为过期
+        if (stale) {
+            save(listing, filterTag);
+        }
+        return false;
+    }
+    ESP_LOGI(TAG, "Directory %s changed: %u -> %u entries", path,
+             (unsigned)listing.size(), (unsigned)fresh.size());
+    save(fresh, filterTag);
+    listing = std::move(fresh);
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DirectoryScanner.h"
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief DirectoryIndex - SD卡上的持久化目录索引
+ *
+ * 每个目录对应一个二进制索引文件，保存排序好的目录项、元数据和名称池。
+ * 打开目录时只需顺序读取一个文件，不再readdir + stat整个目录。
+ *
+ * 索引以目录的修改时间校验：修改时间变化时索引视为过期。FAT文件系统在
+ * 目录内容变化时不一定更新目录时间，所以显示索引后还应在后台调用refresh()
+ * 做一次只读目录项（不stat）的校验，发现变化再增量重建。
+ *
+ * 文件格式：Header | 目录路径 | DirectoryEntry[entryCount] | 名称池
+ */
+class DirectoryIndex {
+public:
+    /**
+     * @brief 读取索引的结果
+     */
+    enum LoadResult {
+        MISSING,  ///< 没有索引或索引损坏
+        STALE,    ///< 索引已读出，但目录修改时间已变化
+        VALID     ///< 索引已读出且目录修改时间一致
+    };
+
+    /**
+     * @brief 读取目录索引（一次顺序读取）
+     * @param path 目录路径
+     * @param listing 输出的目录项，返回STALE或VALID时有效
+     * @param filterTag 生成索引时使用的过滤器标识，不一致时视为MISSING
+     * @return 读取结果
+     */
+    static LoadResult load(const char* path, DirectoryListing& listing, uint32_t filterTag);
+
+    /**
+     * @brief 把目录项写入索引（先写临时文件再替换）
+     * @param listing 已排序的目录项
+     * @param filterTag 生成目录项时使用的过滤器标识
+     * @return 写入成功返回true
+     */
+    static bool save(const DirectoryListing& listing, uint32_t filterTag);
+
+    /**
+     * @brief 重新扫描目录，内容变化时更新索引
+     *
+     * 名称和类型与旧结果相同的项沿用旧元数据，只有新增的项需要stat
+     * @param path 目录路径
+     * @param listing 输入旧结果，目录内容变化时输出新结果
+     * @param filter 过滤器
+     * @param options DirectoryScanner扫描选项
+     * @param filterTag 过滤器标识
+     * @param stale load()返回STALE时为true，内容未变也会重写索引以记录新的修改时间
+     * @param cancelled 返回true时放弃本次校验，可以为空
+     * @return 目录内容变化且listing已更新返回true
+     */
+    static bool refresh(const char* path, DirectoryListing& listing, DirectoryScanner::Filter filter,
+                        uint8_t options, uint32_t filterTag, bool stale = false,
+                        const std::function<bool()>& cancelled = nullptr);
+
+private:
+    /**
+     * @brief 索引文件头
+     */
+    struct Header {
+        uint32_t magic;       ///< 文件标识
+        uint16_t version;     ///< 格式版本
+        uint16_t pathLength;  ///< 目录路径长度
+        uint32_t filterTag;   ///< 过滤器标识
+        uint32_t dirMtime;    ///< 生成索引时目录的修改时间
+        uint32_t entryCount;  ///< 目录项数量
+        uint32_t namesSize;   ///< 名称池字节数
+    };
+
+    static constexpr uint32_t MAGIC = 0x49445042;  ///< "BPDI"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t MAX_ENTRIES = 65535;           ///< 损坏文件保护：目录项数量上限
+    static constexpr uint32_t MAX_NAMES_SIZE = 4 * 1024 * 1024; ///< 损坏文件保护：名称池大小上限
+
+    /**
+     * @brief 获取目录对应的索引文件路径
+     * @param path 目录路径
+     * @param suffix 文件后缀
+     */
+    static std::string indexPathFor(const char* path, const char* suffix);
+
+    /**
+     * @brief 获取目录的修改时间，失败返回0
+     */
+    static uint32_t directoryMtime(const char* path);
+};
\ No newline at end of file
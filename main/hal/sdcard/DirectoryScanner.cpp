@@ -0,0 +1,228 @@
+#include "DirectoryScanner.h"
+#include "esp_log.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstring>
+
+static const char* TAG = "DirectoryScanner";
+
+std::string DirectoryListing::fullPathAt(size_t index) const {
+    std::string fullPath;
+    fullPath.reserve(_path.size() + 1 + _entries[index].nameLength);
+    fullPath += _path;
+    fullPath += '/';
+    fullPath.append(nameAt(index), _entries[index].nameLength);
+    return fullPath;
+}
+
+void DirectoryListing::reset(const std::string& path) {
+    _path = path;
+    _entries.clear();
+    _names.clear();
+}
+
+void DirectoryListing::add(const char* name, size_t length, bool isDirectory, uint32_t size, uint32_t mtime) {
+    DirectoryEntry entry;
+    entry.nameOffset = static_cast<uint32_t>(_names.size());
+    entry.nameLength = static_cast<uint16_t>(length);
+    entry.isDirectory = isDirectory;
+    entry.size = size;
+    entry.mtime = mtime;
+    _names.insert(_names.end(), name, name + length);
+    _names.push_back('\0');
+    _entries.push_back(entry);
+}
+
+void DirectoryListing::append(const DirectoryListing& other, size_t begin, size_t end) {
+    _entries.reserve(_entries.size() + (end - begin));
+    for (size_t i = begin; i < end; i++) {
+        const DirectoryEntry& entry = other._entries[i];
+        add(other.nameAt(i), entry.nameLength, entry.isDirectory, entry.size, entry.mtime);
+    }
+}
+
+/**
+ * @brief 排序规则：目录优先于文件，同类型按名称排序
+ */
+static bool entryLess(bool aIsDirectory, const char* aName, bool bIsDirectory, const char* bName) {
+    if (aIsDirectory != bIsDirectory) {
+        return aIsDirectory;
+    }
+    return strcmp(aName, bName) < 0;
+}
+
+void DirectoryListing::sort() {
+    sortRange(0, _entries.size());
+}
+
+void DirectoryListing::sortRange(size_t begin, size_t end) {
+    const char* names = _names.data();
+    std::sort(_entries.begin() + begin, _entries.begin() + end, [names](const DirectoryEntry& a, const DirectoryEntry& b) {
+        return entryLess(a.isDirectory, names + a.nameOffset, b.isDirectory, names + b.nameOffset);
+    });
+}
+
+void DirectoryListing::mergeRuns(std::vector<size_t> runEnds) {
+    const char* names = _names.data();
+    auto less = [names](const DirectoryEntry& a, const DirectoryEntry& b) {
+        return entryLess(a.isDirectory, names + a.nameOffset, b.isDirectory, names + b.nameOffset);
+    };
+    // 自底向上两两合并相邻的有序段，每一轮段数减半
+    while (runEnds.size() > 1) {
+        std::vector<size_t> merged;
+        size_t begin = 0;
+        for (size_t i = 0; i < runEnds.size(); i += 2) {
+            if (i + 1 < runEnds.size()) {
+                std::inplace_merge(_entries.begin() + begin, _entries.begin() + runEnds[i],
+                                   _entries.begin() + runEnds[i + 1], less);
+                begin = runEnds[i + 1];
+            } else {
+                begin = runEnds[i];
+            }
+            merged.push_back(begin);
+        }
+        runEnds.swap(merged);
+    }
+}
+
+int DirectoryListing::find(const char* name, bool isDirectory) const {
+    const char* names = _names.data();
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), 0,
+                               [names, name, isDirectory](const DirectoryEntry& entry, int) {
+                                   return entryLess(entry.isDirectory, names + entry.nameOffset, isDirectory, name);
+                               });
+    if (it == _entries.end() || it->isDirectory != isDirectory || strcmp(names + it->nameOffset, name) != 0) {
+        return -1;
+    }
+    return static_cast<int>(it - _entries.begin());
+}
+
+bool DirectoryListing::sameEntries(const DirectoryListing& other) const {
+    if (_entries.size() != other._entries.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < _entries.size(); i++) {
+        const DirectoryEntry& a = _entries[i];
+        const DirectoryEntry& b = other._entries[i];
+        if (a.isDirectory != b.isDirectory || a.nameLength != b.nameLength ||
+            memcmp(nameAt(i), other.nameAt(i), a.nameLength) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DirectoryScanner::scan(const char* path, DirectoryListing& listing, Filter filter,
+                            uint8_t options, const std::function<bool()>& cancelled,
+                            const DirectoryListing* previous) {
+    return collect(path, listing, filter, options, cancelled, previous, 0, nullptr);
+}
+
+bool DirectoryScanner::scanStreaming(const char* path, DirectoryListing& listing, Filter filter, uint8_t options,
+                                     size_t firstBatch, const BatchCallback& onBatch,
+                                     const std::function<bool()>& cancelled) {
+    return collect(path, listing, filter, options, cancelled, nullptr, std::max<size_t>(firstBatch, 1), onBatch);
+}
+
+bool DirectoryScanner::collect(const char* path, DirectoryListing& listing, Filter filter,
+                               uint8_t options, const std::function<bool()>& cancelled,
+                               const DirectoryListing* previous, size_t firstBatch,
+                               const BatchCallback& onBatch) {
+    listing.reset(path);
+    DIR* dir = opendir(path);
+    if (dir == nullptr) {
+        ESP_LOGE(TAG, "Cannot open directory: %s", path);
+        return false;
+    }
+
+    bool wantMetadata = (options & WITH_METADATA) != 0;
+    std::string fullPath = path;
+    fullPath += '/';
+    size_t baseLength = fullPath.size();
+    size_t statCalls = 0;
+    bool completed = true;
+    // 分批模式：每批排序后交给回调，批大小从firstBatch开始翻倍，最后合并各批
+    std::vector<size_t> runEnds;
+    size_t runStart = 0;
+    size_t batchSize = firstBatch;
+    auto flushBatch = [&]() {
+        size_t end = listing.size();
+        if (end == runStart) {
+            return;
+        }
+        listing.sortRange(runStart, end);
+        onBatch(listing, runStart, end);
+        runEnds.push_back(end);
+        runStart = end;
+        batchSize = std::min(batchSize * 2, MAX_BATCH);
+    };
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (cancelled && cancelled()) {
+            completed = false;
+            break;
+        }
+        const char* name = entry->d_name;
+        // 跳过当前目录和父目录
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+            continue;
+        }
+        size_t length = strlen(name);
+        if (length > UINT16_MAX) {
+            continue;
+        }
+
+        // 优先使用d_type判断类型，类型未知时才需要stat
+        bool typeKnown = entry->d_type == DT_DIR || entry->d_type == DT_REG;
+        bool isDirectory = entry->d_type == DT_DIR;
+        if (typeKnown && filter != nullptr && !filter(name, isDirectory)) {
+            continue;
+        }
+
+        uint32_t size = 0;
+        uint32_t mtime = 0;
+        if (typeKnown && wantMetadata && previous != nullptr) {
+            // 上一次已经记录过的项沿用元数据
+            int known = previous->find(name, isDirectory);
+            if (known >= 0) {
+                const DirectoryEntry& cached = (*previous)[known];
+                listing.add(name, length, isDirectory, cached.size, cached.mtime);
+                continue;
+            }
+        }
+        if (!typeKnown || wantMetadata) {
+            fullPath.resize(baseLength);
+            fullPath.append(name, length);
+            struct stat st;
+            statCalls++;
+            if (stat(fullPath.c_str(), &st) != 0) {
+                continue;
+            }
+            isDirectory = S_ISDIR(st.st_mode);
+            size = static_cast<uint32_t>(st.st_size);
+            mtime = static_cast<uint32_t>(st.st_mtime);
+            if (!typeKnown && filter != nullptr && !filter(name, isDirectory)) {
+                continue;
+            }
+        }
+        listing.add(name, length, isDirectory, size, mtime);
+        if (onBatch && listing.size() - runStart >= batchSize) {
+            flushBatch();
+        }
+    }
+    closedir(dir);
+
+    if (!completed) {
+        return false;
+    }
+    if (onBatch) {
+        flushBatch();
+        listing.mergeRuns(runEnds);
+    } else {
+        listing.sort();
+    }
+    ESP_LOGD(TAG, "Scanned %s: %u entries, %u stat calls", path, (unsigned)listing.size(), (unsigned)statCalls);
+    return true;
+}
\ No newline at end of file
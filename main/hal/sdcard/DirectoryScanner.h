@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+#include "memory/MemoryPolicy.h"
+
+/**
+ * @brief 目录项（名称保存在DirectoryListing的名称池中）
+ */
+struct DirectoryEntry {
+    uint32_t nameOffset = 0;   ///< 名称在名称池中的偏移
+    uint16_t nameLength = 0;   ///< 名称长度（字节）
+    bool isDirectory = false;  ///< 是否为目录
+    uint32_t size = 0;         ///< 文件大小（未请求元数据时为0）
+    uint32_t mtime = 0;        ///< 修改时间（未请求元数据时为0）
+};
+
+/**
+ * @brief 一次目录扫描的结果
+ * 
+ * 所有名称连续存放在一个名称池中，目录项只保存偏移，父目录路径只保存一次，
+ * 完整路径和显示文字在需要时拼接。名称池和目录项表优先放在PSRAM中。
+ */
+class DirectoryListing {
+public:
+    /**
+     * @brief 扫描的目录
+     */
+    const std::string& path() const { return _path; }
+
+    /**
+     * @brief 目录项数量
+     */
+    size_t size() const { return _entries.size(); }
+
+    /**
+     * @brief 是否没有目录项
+     */
+    bool empty() const { return _entries.empty(); }
+
+    /**
+     * @brief 获取目录项
+     * @param index 索引
+     */
+    const DirectoryEntry& operator[](size_t index) const { return _entries[index]; }
+
+    /**
+     * @brief 获取目录项名称
+     * @param index 索引
+     * @return 以'\0'结尾的名称
+     */
+    const char* nameAt(size_t index) const { return _names.data() + _entries[index].nameOffset; }
+
+    /**
+     * @brief 拼接目录项的完整路径
+     * @param index 索引
+     * @return 完整路径
+     */
+    std::string fullPathAt(size_t index) const;
+
+    /**
+     * @brief 清空结果
+     * @param path 新的目录路径
+     */
+    void reset(const std::string& path);
+
+    /**
+     * @brief 添加目录项
+     * @param name 名称
+     * @param length 名称长度
+     * @param isDirectory 是否为目录
+     * @param size 文件大小
+     * @param mtime 修改时间
+     */
+    void add(const char* name, size_t length, bool isDirectory, uint32_t size, uint32_t mtime);
+
+    /**
+     * @brief 追加另一个结果中的一段目录项
+     * @param other 另一个结果
+     * @param begin 起始索引
+     * @param end 结束索引（不包含）
+     */
+    void append(const DirectoryListing& other, size_t begin, size_t end);
+
+    /**
+     * @brief 占用的内存字节数（容量）
+     */
+    size_t memoryUsage() const {
+        return _entries.capacity() * sizeof(DirectoryEntry) + _names.capacity() + _path.capacity();
+    }
+
+    /**
+     * @brief 排序：目录在前，文件在后，同类型按名称排序
+     */
+    void sort();
+
+    /**
+     * @brief 只排序[begin, end)范围内的目录项
+     */
+    void sortRange(size_t begin, size_t end);
+
+    /**
+     * @brief 合并若干个相邻的有序段，得到整体有序的结果
+     * @param runEnds 各段的结束位置（递增，最后一个等于size()）
+     */
+    void mergeRuns(std::vector<size_t> runEnds);
+
+    /**
+     * @brief 在已排序的结果中查找目录项
+     * @param name 名称
+     * @param isDirectory 是否为目录
+     * @return 索引，找不到返回-1
+     */
+    int find(const char* name, bool isDirectory) const;
+
+    /**
+     * @brief 与另一个结果比较名称和类型是否完全相同（不比较元数据）
+     * @param other 另一个结果
+     * @return 相同返回true
+     */
+    bool sameEntries(const DirectoryListing& other) const;
+
+private:
+    friend class DirectoryIndex;
+
+
+    std::string _path;                    ///< 目录路径
+    PsramVector<DirectoryEntry> _entries; ///< 目录项
+    PsramVector<char> _names;             ///< 名称池
+};
+
+/**
+ * @brief 目录扫描器 - 一次遍历收集目录项
+ * 
+ * 每个目录项只访问一次：VFS提供d_type时直接得到类型，不需要stat；
+ * 只有请求了大小和修改时间，或者类型未知时才对保留下来的项调用一次stat。
+ * 排序只比较缓存的类型和名称，不再访问文件系统。
+ */
+class DirectoryScanner {
+public:
+    /**
+     * @brief 过滤器，返回true表示保留
+     */
+    using Filter = bool (*)(const char* name, bool isDirectory);
+
+    /**
+     * @brief 分批扫描回调：listing中[begin, end)是新读到的一批，已在批内排序
+     */
+    using BatchCallback = std::function<void(const DirectoryListing& listing, size_t begin, size_t end)>;
+
+    static constexpr size_t MAX_BATCH = 256;  ///< 分批扫描时单批的最大项数
+
+    /**
+     * @brief 扫描选项
+     */
+    enum Options : uint8_t {
+        NONE = 0,
+        WITH_METADATA = 1 << 0,  ///< 同时收集文件大小和修改时间
+    };
+
+    /**
+     * @brief 扫描目录并排序
+     * @param path 目录路径
+     * @param listing 输出的扫描结果
+     * @param filter 过滤器，为空时保留所有项
+     * @param options 扫描选项
+     * @param cancelled 返回true时提前结束扫描，可以为空
+     * @param previous 上一次的结果，名称和类型相同的项直接沿用其元数据，不再stat；可以为空
+     * @return 目录可以打开且扫描完成返回true
+     */
+    static bool scan(const char* path, DirectoryListing& listing, Filter filter = nullptr,
+                     uint8_t options = NONE, const std::function<bool()>& cancelled = nullptr,
+                     const DirectoryListing* previous = nullptr);
+
+    /**
+     * @brief 分批扫描目录：边读边把已读到的项交给回调，读完后合并为整体有序的结果
+     *
+     * 第一批读满firstBatch项（通常是一页）就交给回调，之后每批大小翻倍，
+     * 显示第一页的时间与目录大小无关。
+     * @param path 目录路径
+     * @param listing 输出的扫描结果，回调期间只追加不重排，扫描完成后整体有序
+     * @param filter 过滤器，为空时保留所有项
+     * @param options 扫描选项
+     * @param firstBatch 第一批的项数
+     * @param onBatch 每批读完后在扫描线程中调用
+     * @param cancelled 返回true时提前结束扫描，可以为空
+     * @return 目录可以打开且扫描完成返回true
+     */
+    static bool scanStreaming(const char* path, DirectoryListing& listing, Filter filter, uint8_t options,
+                              size_t firstBatch, const BatchCallback& onBatch,
+                              const std::function<bool()>& cancelled = nullptr);
+
+private:
+    /**
+     * @brief 扫描的实现，onBatch为空时读完后一次排序
+     */
+    static bool collect(const char* path, DirectoryListing& listing, Filter filter,
+                        uint8_t options, const std::function<bool()>& cancelled,
+                        const DirectoryListing* previous, size_t firstBatch,
+                        const BatchCallback& onBatch);
+};
\ No newline at end of file
@@ -8,9 +8,11 @@
 extern "C" {
 #endif
 
-// SD卡挂载点
+// SD卡挂载点（主机构建中指向测试用的目录）
+#ifndef SDCARD_MOUNT_POINT
 #define SDCARD_MOUNT_POINT "/sdcard"
-#define SDCARD_BOOKS_DIR "/sdcard/books"
+#endif
+#define SDCARD_BOOKS_DIR SDCARD_MOUNT_POINT "/books"
 
 #define PIN_MISO GPIO_NUM_40
 #define PIN_MOSI GPIO_NUM_38
@@ -6,6 +6,7 @@
 #include "esp_log.h"
 #include "esp_netif.h"
 #include "lwip/inet.h"
+#include "../../jobs/JobScheduler.h"
 #include <string>
 
 static const char *TAG = "HttpServer";
@@ -24,26 +25,51 @@ static esp_err_t handleRootRequest(httpd_req_t *req) {
   return ESP_OK;
 }
 
+/**
+ * 把请求交给后台任务处理，httpd任务可以继续接收其他连接；
+ * 读写SD卡等耗时操作都在工作线程中完成
+ */
+static esp_err_t dispatchToJob(httpd_req_t *req, esp_err_t (*handler)(httpd_req_t *)) {
+  httpd_req_t *asyncReq = nullptr;
+  if (httpd_req_async_handler_begin(req, &asyncReq) != ESP_OK) {
+    ESP_LOGW(TAG, "Async request unavailable, handling inline");
+    return handler(req);
+  }
+  JobScheduler::getInstance().submit([asyncReq, handler](const JobHandle &) {
+    handler(asyncReq);
+    httpd_req_async_handler_complete(asyncReq);
+  });
+  return ESP_OK;
+}
+
+static esp_err_t handleRequestAsync(httpd_req_t *req) {
+  return dispatchToJob(req, handleRequest);
+}
+
+static esp_err_t handleRootRequestAsync(httpd_req_t *req) {
+  return dispatchToJob(req, handleRootRequest);
+}
+
 static void register_uri_handlers(httpd_handle_t server) {
   httpd_uri_t root_config_get = {.uri = "/",
                                        .method = HTTP_GET,
-                                       .handler = handleRootRequest,
+                                       .handler = handleRootRequestAsync,
                                        .user_ctx = NULL};    
   httpd_uri_t uri_device_config_get = {.uri = URI_DEVICE_CONFIG,
                                        .method = HTTP_GET,
-                                       .handler = handleRequest,
+                                       .handler = handleRequestAsync,
                                        .user_ctx = NULL};
   httpd_uri_t uri_device_config_post = {.uri = URI_DEVICE_CONFIG,
                                         .method = HTTP_POST,
-                                        .handler = handleRequest,
+                                        .handler = handleRequestAsync,
                                         .user_ctx = NULL};
   httpd_uri_t uri_books_get = {.uri = "/api/v1/books",
                                .method = HTTP_GET,
-                               .handler = handleRequest,
+                               .handler = handleRequestAsync,
                                .user_ctx = NULL};
   httpd_uri_t uri_books_post = {.uri = "/api/v1/books",
                                 .method = HTTP_POST,
-                                .handler = handleRequest,
+                                .handler = handleRequestAsync,
                                 .user_ctx = NULL};
   httpd_register_uri_handler(server, &root_config_get);
   httpd_register_uri_handler(server, &uri_device_config_get);
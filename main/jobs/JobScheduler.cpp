@@ -0,0 +1,262 @@
+#include "JobScheduler.h"
+#include "esp_log.h"
+#include "freertos/task.h"
+#include <cstdio>
+
+static const char* TAG = "JobScheduler";
+
+JobScheduler::WakeHook JobScheduler::s_wakeHook = nullptr;
+std::atomic<uint32_t> JobScheduler::s_outstanding{0};
+
+JobHandle::State::State() {
+    finished = xSemaphoreCreateBinary();
+}
+
+JobHandle::State::~State() {
+    if (finished != nullptr) {
+        vSemaphoreDelete(finished);
+    }
+}
+
+void JobHandle::cancel() const {
+    if (_state) {
+        _state->cancelled = true;
+    }
+}
+
+bool JobHandle::isCancelled() const {
+    return _state && _state->cancelled.load();
+}
+
+bool JobHandle::isDone() const {
+    return !_state || _state->done.load();
+}
+
+bool JobHandle::wait(TickType_t timeout) const {
+    if (isDone()) {
+        return true;
+    }
+    if (_state->finished == nullptr || xSemaphoreTake(_state->finished, timeout) != pdTRUE) {
+        return isDone();
+    }
+    // 放回信号量，让其他等待者也能返回
+    xSemaphoreGive(_state->finished);
+    return true;
+}
+
+JobScheduler& JobScheduler::getInstance() {
+    static JobScheduler instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+bool JobScheduler::init() {
+    if (_available != nullptr) {
+        return true;
+    }
+    _uiTask = xTaskGetCurrentTaskHandle();
+    bool ok = true;
+    for (QueueHandle_t& queue : _queues) {
+        queue = xQueueCreate(QUEUE_LENGTH, sizeof(Job*));
+        ok = ok && queue != nullptr;
+    }
+    _completions = xQueueCreate(COMPLETION_QUEUE_LENGTH, sizeof(Job*));
+    SemaphoreHandle_t available = xSemaphoreCreateCounting(QUEUE_LENGTH * 3, 0);
+    ok = ok && _completions != nullptr && available != nullptr;
+
+    size_t workers = 0;
+    if (ok) {
+        _available = available;
+        for (size_t i = 0; i < WORKER_COUNT; i++) {
+            char name[16];
+            snprintf(name, sizeof(name), "job_worker_%u", (unsigned)i);
+            if (xTaskCreatePinnedToCore(&JobScheduler::workerTask, name, WORKER_STACK, this,
+                                        WORKER_PRIORITY, nullptr, WORKER_CORE) == pdPASS) {
+                workers++;
+            }
+        }
+    }
+    if (workers == 0) {
+        ESP_LOGE(TAG, "Failed to start job workers, running jobs synchronously");
+        for (QueueHandle_t& queue : _queues) {
+            if (queue != nullptr) {
+                vQueueDelete(queue);
+                queue = nullptr;
+            }
+        }
+        if (_completions != nullptr) {
+            vQueueDelete(_completions);
+            _completions = nullptr;
+        }
+        if (available != nullptr) {
+            vSemaphoreDelete(available);
+        }
+        _available = nullptr;
+        return false;
+    }
+    ESP_LOGI(TAG, "%u job worker(s) on core %d", (unsigned)workers, (int)WORKER_CORE);
+    return true;
+}
+
+JobHandle JobScheduler::submit(Work work, Completion onDone, JobPriority priority, std::weak_ptr<void> owner) {
+    // 没有所有者时传入的是空的weak_ptr
+    bool hasOwner = !owner.expired();
+    Job* job = new Job{std::move(work), std::move(onDone), std::make_shared<JobHandle::State>(), std::move(owner), hasOwner,
+                       priority};
+    s_outstanding++;
+    JobHandle handle(job->state);
+
+    if (_available == nullptr) {
+        // 没有工作线程：在当前任务中同步执行
+        ESP_LOGW(TAG, "Running job synchronously");
+        run(job);
+        finish(job);
+        complete(job);
+        return handle;
+    }
+    QueueHandle_t queue = _queues[static_cast<size_t>(priority)];
+    if (xQueueSend(queue, &job, 0) != pdTRUE) {
+        if (isUiTask()) {
+            // 队列已满：UI任务不能等待工作线程（工作线程可能正等着UI任务清空完成队列），
+            // 暂存到下次dispatchCompletions
+            ESP_LOGW(TAG, "Job queue full, deferring job");
+            _deferred.push_back(job);
+            _hasDeferred = true;
+            return handle;
+        }
+        xQueueSend(queue, &job, portMAX_DELAY);
+    }
+    xSemaphoreGive(_available);
+    return handle;
+}
+
+void JobScheduler::post(const JobHandle& job, Completion callback) {
+    // 借用任务的共享状态，任务被取消时一起丢弃
+    Job* progress = new Job{nullptr, std::move(callback), job._state, std::weak_ptr<void>(), false, JobPriority::HIGH};
+    s_outstanding++;
+    if (_completions == nullptr || isUiTask()) {
+        // 同步执行模式或已经在UI任务中：直接执行，避免UI任务等待自己清空完成队列
+        complete(progress);
+        return;
+    }
+    xQueueSend(_completions, &progress, portMAX_DELAY);
+    wake();
+}
+
+JobScheduler::Job* JobScheduler::takeNextJob() {
+    Job* job = nullptr;
+    for (QueueHandle_t queue : _queues) {
+        if (xQueueReceive(queue, &job, 0) == pdTRUE) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobScheduler::isAbandoned(const Job* job) {
+    return job->state->cancelled.load() || (job->hasOwner && job->owner.expired());
+}
+
+void JobScheduler::run(Job* job) {
+    if (job->work && !isAbandoned(job)) {
+        job->work(JobHandle(job->state));
+    }
+}
+
+void JobScheduler::finish(Job* job) {
+    job->state->done = true;
+    if (job->state->finished != nullptr) {
+        xSemaphoreGive(job->state->finished);
+    }
+}
+
+void JobScheduler::complete(Job* job) {
+    if (job->onDone && !isAbandoned(job)) {
+        job->onDone();
+    }
+    delete job;
+    s_outstanding--;
+}
+
+bool JobScheduler::isUiTask() const {
+    return _uiTask != nullptr && xTaskGetCurrentTaskHandle() == _uiTask;
+}
+
+void JobScheduler::flushDeferred() {
+    size_t pending = _deferred.size();
+    for (size_t i = 0; i < pending; i++) {
+        Job* job = _deferred.front();
+        _deferred.pop_front();
+        if (xQueueSend(_queues[static_cast<size_t>(job->priority)], &job, 0) != pdTRUE) {
+            // 仍然放不下，保持原来的顺序留到下次
+            _deferred.push_back(job);
+            continue;
+        }
+        xSemaphoreGive(_available);
+    }
+    _hasDeferred = !_deferred.empty();
+}
+
+void JobScheduler::wake() {
+    if (s_wakeHook != nullptr) {
+        s_wakeHook();
+    }
+}
+
+void JobScheduler::setWakeHook(WakeHook hook) {
+    s_wakeHook = hook;
+}
+
+bool JobScheduler::runUntilIdle(TickType_t timeout) {
+    TickType_t waited = 0;
+    while (true) {
+        dispatchCompletions();
+        if (s_outstanding.load() == 0) {
+            return true;
+        }
+        if (timeout != portMAX_DELAY && waited >= timeout) {
+            return false;
+        }
+        vTaskDelay(1);
+        waited++;
+    }
+}
+
+void JobScheduler::dispatchCompletions() {
+    if (_completions == nullptr) {
+        return;
+    }
+    if (_hasDeferred.load()) {
+        flushDeferred();
+    }
+    Job* job = nullptr;
+    while (xQueueReceive(_completions, &job, 0) == pdTRUE) {
+        complete(job);
+    }
+}
+
+void JobScheduler::workerTask(void* param) {
+    JobScheduler* self = static_cast<JobScheduler*>(param);
+    while (true) {
+        if (xSemaphoreTake(self->_available, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        Job* job = self->takeNextJob();
+        if (job == nullptr) {
+            continue;
+        }
+        if (self->_hasDeferred.load()) {
+            // 队列有了空位，唤醒UI任务放入暂存的任务
+            wake();
+        }
+        run(job);
+        finish(job);
+        if (!job->onDone) {
+            // 没有完成回调的任务直接在工作线程中结束，不占用完成队列
+            complete(job);
+            continue;
+        }
+        xQueueSend(self->_completions, &job, portMAX_DELAY);
+        // 唤醒UI任务处理结果
+        wake();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief 后台任务优先级
+ */
+enum class JobPriority : uint8_t {
+    HIGH = 0,  ///< 用户正在等待的结果（打开目录、页面内容）
+    NORMAL,    ///< 普通后台工作
+    LOW,       ///< 预取等可以推迟的工作
+};
+
+class JobScheduler;
+
+/**
+ * @brief 后台任务句柄，同时作为取消令牌
+ * 
+ * 可以复制，所有副本指向同一个任务。工作函数通过isCancelled检查是否应该提前结束。
+ */
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    /**
+     * @brief 请求取消任务：尚未开始的任务不再执行，正在执行的任务需要自行检查isCancelled
+     */
+    void cancel() const;
+
+    /**
+     * @brief 是否已请求取消
+     * @return 已取消返回true
+     */
+    bool isCancelled() const;
+
+    /**
+     * @brief 任务是否已经结束（执行完成或因取消被跳过）
+     * @return 已结束返回true
+     */
+    bool isDone() const;
+
+    /**
+     * @brief 等待任务结束（不能在同一个工作线程中等待排在后面的任务）
+     * @param timeout 超时时间
+     * @return 任务已结束返回true
+     */
+    bool wait(TickType_t timeout = portMAX_DELAY) const;
+
+    /**
+     * @brief 句柄是否指向一个任务
+     */
+    bool isValid() const { return _state != nullptr; }
+
+private:
+    friend class JobScheduler;
+
+    /**
+     * @brief 任务的共享状态
+     */
+    struct State {
+        std::atomic<bool> cancelled{false};       ///< 是否已请求取消
+        std::atomic<bool> done{false};            ///< 是否已结束
+        SemaphoreHandle_t finished = nullptr;     ///< 结束时释放，用于wait
+
+        State();
+        ~State();
+    };
+
+    explicit JobHandle(std::shared_ptr<State> state) : _state(std::move(state)) {}
+
+    std::shared_ptr<State> _state;  ///< 共享状态
+};
+
+/**
+ * @brief 后台任务调度器 - 核心0上的工作线程池
+ * 
+ * 单例模式。UI任务固定在核心1上，目录扫描、排序、网络请求等耗时工作提交到这里，
+ * 由核心0上数量固定的工作线程按优先级取出执行。
+ * 完成回调放入完成队列，由UI循环每次唤醒时调用dispatchCompletions在UI任务中执行，
+ * 因此回调中可以安全地修改视图。任务被取消或所有者销毁后不再执行完成回调。
+ * 工作和回调都不会在提交它的UI任务中同步执行：UI任务持有页面状态的锁，
+ * 工作线程又可能正等着UI任务清空完成队列。
+ */
+class JobScheduler {
+public:
+    static const BaseType_t WORKER_CORE = 0;           ///< 工作线程所在核心（UI任务在核心1）
+    static const size_t WORKER_COUNT = 2;              ///< 工作线程数量
+    static const uint32_t WORKER_STACK = 6144;         ///< 工作线程栈大小（目录扫描、WiFi启动）
+    static const UBaseType_t WORKER_PRIORITY = 1;      ///< 工作线程的FreeRTOS优先级
+    static const UBaseType_t QUEUE_LENGTH = 16;        ///< 每个优先级排队的任务数量上限
+    static const UBaseType_t COMPLETION_QUEUE_LENGTH = 32; ///< 完成队列长度
+
+    using Work = std::function<void(const JobHandle& job)>;
+    using Completion = std::function<void()>;
+
+    /**
+     * @brief 完成队列中有新回调时的通知类型
+     */
+    typedef void (*WakeHook)();
+
+    /**
+     * @brief 获取单例实例
+     * @return JobScheduler单例实例引用
+     */
+    static JobScheduler& getInstance();
+
+    /**
+     * @brief 创建工作线程和队列，并把调用者记为UI任务（之后可以用setUiTask修改）
+     * @return 成功返回true，失败时之后提交的任务在调用者任务中同步执行
+     */
+    bool init();
+
+    /**
+     * @brief 设置执行完成回调的UI任务
+     * @param task UI任务句柄
+     */
+    void setUiTask(TaskHandle_t task) { _uiTask = task; }
+
+    /**
+     * @brief 提交后台任务
+     * 
+     * 任务队列已满时，其他任务中的调用者等待队列有空位；
+     * UI任务不能等待，任务暂存在UI任务中，下次dispatchCompletions时再放入队列。
+     * @param work 在工作线程中执行的工作（不能访问视图），参数为任务自身的句柄，用于检查取消
+     * @param onDone 完成后在UI任务中执行的回调，可以为空
+     * @param priority 优先级
+     * @param owner 所有者的存活标记，失效后不再执行工作和回调；为空表示没有所有者
+     * @return 任务句柄
+     */
+    JobHandle submit(Work work, Completion onDone = nullptr, JobPriority priority = JobPriority::NORMAL,
+                     std::weak_ptr<void> owner = std::weak_ptr<void>());
+
+    /**
+     * @brief 提交带返回值的后台任务，结果在UI任务中交给onResult
+     * @param work 在工作线程中计算结果
+     * @param onResult 在UI任务中处理结果
+     * @param priority 优先级
+     * @param owner 所有者的存活标记
+     * @return 任务句柄
+     */
+    template <typename T>
+    JobHandle submitForResult(std::function<T(const JobHandle& job)> work, std::function<void(T& result)> onResult,
+                              JobPriority priority = JobPriority::NORMAL,
+                              std::weak_ptr<void> owner = std::weak_ptr<void>()) {
+        auto result = std::make_shared<T>();
+        return submit(
+            [work, result](const JobHandle& job) { *result = work(job); },
+            [onResult, result]() { onResult(*result); }, priority, std::move(owner));
+    }
+
+    /**
+     * @brief 在工作线程中把中间结果交给UI任务（例如分批加载的进度）
+     * 
+     * 回调与任务的完成回调进入同一个队列，按提交顺序执行；任务被取消后不再执行。
+     * 完成队列已满时会阻塞工作线程，UI来不及处理时自然限流；在UI任务中调用时直接执行回调。
+     * @param job 正在执行的任务
+     * @param callback 在UI任务中执行的回调
+     */
+    void post(const JobHandle& job, Completion callback);
+
+    /**
+     * @brief 在UI任务中执行已完成任务的回调，并把暂存的任务放入队列（每次UI循环调用一次）
+     */
+    void dispatchCompletions();
+
+    /**
+     * @brief 等待所有已提交的任务结束，并在调用者任务中执行它们的回调
+     * 
+     * 回调中新提交的任务也会一起等待。用于基准测试和主机测试在采样前让页面加载完成，
+     * 调用者就是执行回调的UI任务，不能在UI循环中使用。
+     * @param timeout 超时时间
+     * @return 所有任务都已结束返回true，超时返回false
+     */
+    bool runUntilIdle(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief 设置完成队列中有新回调时的通知（用于唤醒UI循环）
+     * @param hook 回调函数，传入nullptr取消
+     */
+    static void setWakeHook(WakeHook hook);
+
+private:
+    /**
+     * @brief 排队中的任务
+     */
+    struct Job {
+        Work work;                              ///< 后台工作
+        Completion onDone;                      ///< 完成回调
+        std::shared_ptr<JobHandle::State> state;///< 共享状态
+        std::weak_ptr<void> owner;              ///< 所有者存活标记
+        bool hasOwner;                          ///< 是否有所有者
+        JobPriority priority;                   ///< 优先级
+    };
+
+    JobScheduler() = default;
+    ~JobScheduler() = default;
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    static void workerTask(void* param);
+
+    /**
+     * @brief 按优先级取出下一个任务
+     * @return 任务，没有时返回nullptr
+     */
+    Job* takeNextJob();
+
+    /**
+     * @brief 执行任务的工作（已取消或所有者已销毁时跳过）
+     */
+    static void run(Job* job);
+
+    /**
+     * @brief 标记任务结束，唤醒等待者
+     */
+    static void finish(Job* job);
+
+    /**
+     * @brief 在需要时执行完成回调，然后释放任务
+     */
+    static void complete(Job* job);
+
+    /**
+     * @brief 任务是否应该跳过（已取消或所有者已销毁）
+     */
+    static bool isAbandoned(const Job* job);
+
+    /**
+     * @brief 通知UI任务有回调等待执行
+     */
+    static void wake();
+
+    /**
+     * @brief 当前是否在UI任务中
+     */
+    bool isUiTask() const;
+
+    /**
+     * @brief 把UI任务中暂存的任务放入队列（只在UI任务中调用）
+     */
+    void flushDeferred();
+
+    static WakeHook s_wakeHook;                  ///< 完成队列有新回调时的通知
+    static std::atomic<uint32_t> s_outstanding;  ///< 尚未释放的任务和中间结果数量
+
+    QueueHandle_t _queues[3] = {};               ///< 各优先级的任务队列（Job*）
+    SemaphoreHandle_t _available = nullptr;      ///< 排队任务计数
+    QueueHandle_t _completions = nullptr;        ///< 已完成的任务（Job*）
+    TaskHandle_t _uiTask = nullptr;              ///< 执行完成回调的UI任务
+    std::deque<Job*> _deferred;                  ///< 队列已满时UI任务暂存的任务（只在UI任务中访问）
+    std::atomic<bool> _hasDeferred{false};       ///< 是否有暂存的任务，工作线程取出任务后据此唤醒UI任务
+};
\ No newline at end of file
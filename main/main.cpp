@@ -12,12 +12,18 @@
 #include "pages/settings/SettingsPage.h"
 #include "pages/launcher/LauncherPage.h"
 #include "pages/message/MessagePage.h"
-#include "refresh_counter/RefreshCounter.h"
+#include "refresh_counter/RefreshPolicy.h"
+#include "refresh_counter/IdleRefreshScheduler.h"
 #include "pages/httpserver/HttpServerPage.h"
 #include "hal/sdcard/sdcard.h"
 #include "ui_kit/UIKIT.h"
 #include "gestures/TouchGestureDetector.h"
+#include "gestures/InputEventQueue.h"
 #include "pages/file_browser/paged_file_browser.h"
+#include "benchmark/UiBenchmark.h"
+#include "event_loop/UiEventLoop.h"
+#include "render/DisplayPipeline.h"
+#include "jobs/JobScheduler.h"
 
 #include "config/DeviceConfigManager.h"
 
@@ -60,6 +66,8 @@ extern "C" void app_main(void)
     // A. 初始化硬件
     auto cfg = m5::M5Unified::config();
     M5.begin(cfg);
+    // 页面按屏幕尺寸创建视图，不直接访问显示设备
+    PageManager::getInstance().setScreenSize(M5.Display.width(), M5.Display.height());
 
     if(sdcard_init() != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize SD card");
@@ -75,19 +83,41 @@ extern "C" void app_main(void)
 
     
 
+    // 目录扫描、页面初始化等耗时工作在核心0上的工作线程中执行
+    JobScheduler::getInstance().init();
+
     // 启动启动器页面（作为首页）
     PageManager::getInstance().startActivity(PageType::MENU);
 
-    // 初始化刷新计数器
-    RefreshCounter::getInstance().init(DeviceConfigManager::getInstance().getConfig().refreshInterval); // 每10次刷新执行一次全刷
-    // RefreshCounter::getInstance().init(10); // 每10次刷新执行一次全刷
+    // 初始化刷新策略（按配置选择刷新模式和残影清理阈值）
+    RefreshPolicy::getInstance().init(DeviceConfigManager::getInstance().getConfig(), M5.Display.width(), M5.Display.height());
+    ESP_LOGI(TAG, "Refresh clean threshold: %u", (unsigned)RefreshPolicy::getInstance().getCleanThreshold());
+    // 残影清理推迟到无操作的空闲时间
+    IdleRefreshScheduler::getInstance().init(DeviceConfigManager::getInstance().getConfig().idleRefreshDelay * 1000);
+
+#if UI_BENCHMARK_ENABLED
+    // 在启动UI任务前运行渲染基准测试，避免与UI任务争用视图树
+    UiBenchmark::run(M5.Display);
+#endif
+
+    // 双缓冲：UI任务绘制后台缓冲，显示任务在另一个核心上刷新面板
+    DisplayPipeline::getInstance().init();
+
+    // 事件驱动的UI循环：空闲时阻塞等待触摸中断/重绘请求/定时器，并允许浅睡眠
+    UiEventLoop::getInstance().init(DeviceConfigManager::getInstance().getConfig().uiLoopMode);
 
     // UI主循环任务
     xTaskCreatePinnedToCore([](void *param)
                             {
         PageManager* pageMgr = static_cast<PageManager*>(param);
-        m5gfx::M5GFX& display = M5.Display;
         TouchGestureDetector gestureDetector;
+        InputEventQueue inputQueue;
+        DirtyRegion dirtyRegion;
+        UiEventLoop& eventLoop = UiEventLoop::getInstance();
+        DisplayPipeline& pipeline = DisplayPipeline::getInstance();
+        IdleRefreshScheduler& idleRefresh = IdleRefreshScheduler::getInstance();
+        // 完成回调在这个任务中执行，队列已满时这里提交的任务暂存而不是同步执行
+        JobScheduler::getInstance().setUiTask(xTaskGetCurrentTaskHandle());
         
         while(1) {
 
@@ -101,36 +131,51 @@ extern "C" void app_main(void)
             if (direction != TouchGestureDetector::SwipeDirection::NONE) {
                 ESP_LOGD(TAG, "Detected swipe gesture: %d", direction);
                 // 检测到滑动手势
-                // 将滑动事件传递给当前页面
-                pageMgr->onSwipe(direction);
+                inputQueue.push(InputEvent::swipe(direction));
             } else if (touch.wasPressed()) {
                 // 普通触摸事件（非滑动）
-                // 处理页面点击事件
-                pageMgr->onClick(touch.x, touch.y);
-            } 
+                inputQueue.push(InputEvent::tap(touch.x, touch.y));
+            }
+            if (touch.isPressed()) {
+                // 有输入时推迟残影清理，正在进行的清理尽快停止
+                idleRefresh.onInput();
+            }
+
+            // 面板刷新期间暂存输入，刷新完成后合并分发，只绘制最终状态
+            InputEvent event;
+            while (!pipeline.isRefreshing() && inputQueue.pop(event)) {
+                if (event.type == InputEvent::Type::SWIPE) {
+                    // 将滑动事件传递给当前页面
+                    pageMgr->onSwipe(event.direction, event.count);
+                } else {
+                    // 处理页面点击事件
+                    pageMgr->onClick(event.x, event.y);
+                }
+            }
+            
+            // 后台任务完成后在UI任务中更新页面内容
+            JobScheduler::getInstance().dispatchCompletions();
             
             bool shouldUpdateDisplay = pageMgr->getCurrentPage() ? pageMgr->getCurrentPage()->isDirty() : false;
                         
             
             if (shouldUpdateDisplay) {
                 ESP_LOGD(TAG, "UI需要重绘");
-                // 绘制当前页面
-                display.startWrite();
-                pageMgr->draw(display);
-                display.endWrite();                
-                // 显示更新 - 使用刷新计数器来决定刷新模式
-                M5.Display.setEpdMode(RefreshCounter::getInstance().refresh());
-                M5.Display.display();
-            }            
-            lgfx::v1::delay(10);
-            // vTaskDelay(pdMS_TO_TICKS(50)); // 20 FPS
-            // // 优化：如果没有需要更新的内容，适当延长延迟以节省电力
-            // if (shouldUpdateDisplay) {
-            //     // 如果刚刚更新了显示，短暂延迟
-            //     vTaskDelay(pdMS_TO_TICKS(50)); // 20 FPS
-            // } else {
-            //     // 如果没有更新，可以更长时间休眠以节省电力
-            //     vTaskDelay(pdMS_TO_TICKS(50)); // 5 FPS - 更低的轮询频率
-            // }
+                // 绘制当前页面到后台缓冲
+                DrawSurface& target = pipeline.drawTarget();
+                target.startWrite();
+                pageMgr->draw(target);
+                target.endWrite();
+                // 只提交发生变化的区域，页面切换时整屏刷新
+                bool fullRefresh = pageMgr->takeDirtyRegion(dirtyRegion);
+                dirtyRegion.clipTo(Rect{0, 0, (int16_t)target.width(), (int16_t)target.height()});
+                pipeline.submit(dirtyRegion, fullRefresh);
+            }
+            // 面板空闲时交换缓冲并开始刷新；正在刷新时下一帧保留到刷新完成
+            pipeline.present();
+            // 空闲足够久时清理累计的残影
+            idleRefresh.poll();
+            // 等待下一个事件；手指仍在屏幕上时继续按10ms采样
+            eventLoop.waitForEvent(touch.isPressed() || gestureDetector.isTouching());
         } }, "ui_loop_task", 8192, &PageManager::getInstance(), 1, NULL, 1);
 }
\ No newline at end of file
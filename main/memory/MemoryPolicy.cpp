@@ -0,0 +1,99 @@
+#include "MemoryPolicy.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <atomic>
+
+static const char* TAG = "MemoryPolicy";
+
+/**
+ * @brief 标签的分配方式
+ */
+struct TagPolicy {
+    const char* name;    ///< 标签名称
+    uint32_t preferred;  ///< 首选内存
+    uint32_t fallback;   ///< 首选内存不足时使用的内存，0表示不退回
+};
+
+static const TagPolicy POLICIES[] = {
+    {"ui_internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT},
+    {"bulk_psram", MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT},
+    {"dma", MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL, 0},
+};
+static_assert(sizeof(POLICIES) / sizeof(POLICIES[0]) == static_cast<size_t>(MemoryTag::COUNT),
+              "Every MemoryTag needs a policy");
+
+/**
+ * @brief 标签的统计计数（工作线程也会分配，使用原子操作）
+ */
+struct TagCounters {
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> peakBytes{0};
+    std::atomic<uint32_t> allocations{0};
+    std::atomic<uint32_t> fallbacks{0};
+    std::atomic<uint32_t> failures{0};
+};
+
+static TagCounters s_counters[static_cast<size_t>(MemoryTag::COUNT)];
+
+void* MemoryPolicy::allocate(MemoryTag tag, size_t size) {
+    size_t index = static_cast<size_t>(tag);
+    const TagPolicy& policy = POLICIES[index];
+    TagCounters& counters = s_counters[index];
+
+    void* ptr = heap_caps_malloc(size ? size : 1, policy.preferred);
+    if (ptr == nullptr && policy.fallback != 0) {
+        ptr = heap_caps_malloc(size ? size : 1, policy.fallback);
+        if (ptr != nullptr) {
+            counters.fallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (ptr == nullptr) {
+        counters.failures.fetch_add(1, std::memory_order_relaxed);
+        ESP_LOGW(TAG, "Failed to allocate %u bytes for %s", (unsigned)size, policy.name);
+        return nullptr;
+    }
+
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t bytes = counters.bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (bytes > peak && !counters.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void MemoryPolicy::release(MemoryTag tag, void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    s_counters[static_cast<size_t>(tag)].bytes.fetch_sub(size, std::memory_order_relaxed);
+    heap_caps_free(ptr);
+}
+
+MemoryPolicy::TagStats MemoryPolicy::getStats(MemoryTag tag) {
+    const TagCounters& counters = s_counters[static_cast<size_t>(tag)];
+    TagStats stats;
+    stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.fallbacks = counters.fallbacks.load(std::memory_order_relaxed);
+    stats.failures = counters.failures.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* MemoryPolicy::tagName(MemoryTag tag) {
+    return tag < MemoryTag::COUNT ? POLICIES[static_cast<size_t>(tag)].name : "unknown";
+}
+
+void MemoryPolicy::logUsage() {
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); i++) {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+        TagStats stats = getStats(tag);
+        ESP_LOGI(TAG, "%-11s %7u bytes (peak %u), %u allocs, %u fallbacks, %u failures", tagName(tag),
+                 (unsigned)stats.bytes, (unsigned)stats.peakBytes, (unsigned)stats.allocations,
+                 (unsigned)stats.fallbacks, (unsigned)stats.failures);
+    }
+    ESP_LOGI(TAG, "free internal %u (largest %u), free psram %u",
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+             (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL),
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 内存用途标签，决定从哪种内存分配
+ */
+enum class MemoryTag : uint8_t {
+    UI_INTERNAL = 0,  ///< 每帧都会访问的小对象（视图、当前页数据），放在内部SRAM，不足时退回PSRAM
+    BULK_PSRAM,       ///< 大块数据（目录表、名称池、帧缓存），放在PSRAM，没有PSRAM时退回内部SRAM
+    DMA,              ///< 需要DMA访问的缓冲区，只能放在内部SRAM
+    COUNT
+};
+
+/**
+ * @brief MemoryPolicy - 按用途选择内部SRAM或PSRAM的分配策略
+ *
+ * 所有经过这里的分配按标签统计当前用量、峰值、退回次数和失败次数，
+ * 运行时可以通过getStats或logUsage查看。
+ */
+class MemoryPolicy {
+public:
+    /**
+     * @brief 单个标签的统计信息
+     */
+    struct TagStats {
+        size_t bytes = 0;          ///< 当前占用的字节数
+        size_t peakBytes = 0;      ///< 峰值字节数
+        uint32_t allocations = 0;  ///< 累计分配次数
+        uint32_t fallbacks = 0;    ///< 首选内存不足、退回到其他内存的次数
+        uint32_t failures = 0;     ///< 分配失败次数
+    };
+
+    /**
+     * @brief 按标签分配内存
+     * @param tag 用途标签
+     * @param size 字节数
+     * @return 内存指针，失败返回nullptr
+     */
+    static void* allocate(MemoryTag tag, size_t size);
+
+    /**
+     * @brief 释放allocate分配的内存
+     * @param tag 分配时的标签
+     * @param ptr 内存指针，可以为nullptr
+     * @param size 分配时的字节数
+     */
+    static void release(MemoryTag tag, void* ptr, size_t size);
+
+    /**
+     * @brief 获取标签的统计信息
+     * @param tag 用途标签
+     */
+    static TagStats getStats(MemoryTag tag);
+
+    /**
+     * @brief 获取标签名称
+     * @param tag 用途标签
+     */
+    static const char* tagName(MemoryTag tag);
+
+    /**
+     * @brief 输出所有标签的用量以及内部SRAM和PSRAM的剩余空间
+     */
+    static void logUsage();
+};
+
+/**
+ * @brief 按标签分配的STL分配器
+ *
+ * 内存不足时与operator new在禁用异常时的行为一致（abort）
+ */
+template <typename T, MemoryTag Tag>
+struct TaggedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() = default;
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+    T* allocate(size_t n) {
+        void* p = MemoryPolicy::allocate(Tag, n * sizeof(T));
+        if (p == nullptr) {
+            abort();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) { MemoryPolicy::release(Tag, p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+    template <typename U>
+    bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+};
+
+template <typename T>
+using InternalAllocator = TaggedAllocator<T, MemoryTag::UI_INTERNAL>;  ///< 内部SRAM分配器
+template <typename T>
+using PsramAllocator = TaggedAllocator<T, MemoryTag::BULK_PSRAM>;      ///< PSRAM分配器
+
+template <typename T>
+using InternalVector = std::vector<T, InternalAllocator<T>>;  ///< 放在内部SRAM的vector
+template <typename T>
+using PsramVector = std::vector<T, PsramAllocator<T>>;        ///< 放在PSRAM的vector
+
+using PsramString = std::basic_string<char, std::char_traits<char>, PsramAllocator<char>>;  ///< 放在PSRAM的字符串
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Page.h"
 #include "PageManager.h"
 #include "esp_log.h"
+#include "render/FrameDiff.h"
 
 static const char* TAG = "Page";
 
@@ -17,6 +18,7 @@ Page::~Page() {
         delete _rootView;
         _rootView = nullptr;
     }
+    releaseCanvas();
 }
 
 void Page::onCreate() {
@@ -29,8 +31,10 @@ void Page::onStart() {
 
 void Page::onResume() {
     ESP_LOGD(TAG, "Page %s (type: %d) onResume", _pageName.c_str(), static_cast<int>(_pageType));
-    // 当页面恢复时，标记为需要重绘
-    if (_rootView != nullptr) {
+    // 有离屏画布时直接把画布重新合成到屏幕，否则标记为需要重绘
+    if (_canvas != nullptr) {
+        _composeAll = true;
+    } else if (_rootView != nullptr) {
         _rootView->markDirty();
     }
 }
@@ -51,17 +55,140 @@ void Page::onDestroy() {
     ESP_LOGD(TAG, "Page %s (type: %d) onDestroy", _pageName.c_str(), static_cast<int>(_pageType));
 }
 
+void Page::onSaveState(PageState& state) {
+    ESP_LOGD(TAG, "Page %s (type: %d) onSaveState", _pageName.c_str(), static_cast<int>(_pageType));
+}
+
+void Page::onRestoreState(const PageState& state) {
+    ESP_LOGD(TAG, "Page %s (type: %d) onRestoreState", _pageName.c_str(), static_cast<int>(_pageType));
+}
+
+JobHandle Page::runInBackground(std::function<void()> work, std::function<void()> onDone) {
+    // 用户正在等待页面内容，使用高优先级；完成回调中创建的视图也放在页面的内存池里
+    // （页面销毁后回调不会执行，捕获this是安全的）
+    JobScheduler::Completion completion = nullptr;
+    if (onDone) {
+        completion = [this, onDone]() {
+            ViewArena::Scope scope(_viewArena);
+            onDone();
+        };
+    }
+    return JobScheduler::getInstance().submit([work](const JobHandle&) { work(); }, std::move(completion),
+                                              JobPriority::HIGH, _lifeToken);
+}
+
+size_t Page::getCanvasBytes() const {
+    return _canvas != nullptr ? _canvas->bufferLength() : 0;
+}
+
 bool Page::isDirty() const {
+    if (_composeAll) {
+        return true;
+    }
     if (_rootView != nullptr) {
         return _rootView->isDirty();
     }
     return false;
 }
 
-void Page::draw(m5gfx::M5GFX& display) {
-    if (_rootView != nullptr) {
+void Page::draw(DrawSurface& display) {
+    if (_rootView == nullptr) {
+        return;
+    }
+    if (!_canvasEnabled || !ensureCanvas(display)) {
         _rootView->draw(display);
+        // 直接绘制到了屏幕上，上一次推送的帧已不可信
+        FrameDiff::getInstance().invalidate();
+        return;
+    }
+
+    // 视图绘制到画布上，再只把实际变化的像素合成到屏幕
+    _rootView->draw(*_canvas);
+    DirtyRegion damage;
+    _rootView->takeDirtyRegion(damage);
+
+    FrameDiff& frameDiff = FrameDiff::getInstance();
+    DirtyRegion changed;
+    if (_composeAll) {
+        _composeAll = false;
+        frameDiff.diff(*_canvas, Rect{0, 0, static_cast<int16_t>(_canvas->width()), static_cast<int16_t>(_canvas->height())}, changed);
+    } else {
+        for (const Rect& rect : damage) {
+            frameDiff.diff(*_canvas, rect, changed);
+        }
+    }
+    for (const Rect& rect : changed) {
+        composeRect(display, rect);
+    }
+    _composedRegion.add(changed);
+}
+
+bool Page::takeDirtyRegion(DirtyRegion& region) {
+    if (_canvas != nullptr) {
+        // 经过帧差分，区域是精确的：为空表示没有像素变化
+        region.add(_composedRegion);
+        _composedRegion.clear();
+        return true;
+    }
+    if (_rootView != nullptr) {
+        _rootView->takeDirtyRegion(region);
+    }
+    return false;
+}
+
+void Page::setRetainedCanvasEnabled(bool enabled) {
+    if (_canvasEnabled == enabled) {
+        return;
+    }
+    _canvasEnabled = enabled;
+    if (!enabled) {
+        releaseCanvas();
+        // 之后直接绘制到屏幕，需要完整重绘一次
+        if (_rootView != nullptr) {
+            _rootView->forceRedraw();
+        }
+    }
+}
+
+bool Page::ensureCanvas(DrawSurface& display) {
+    if (_canvas != nullptr) {
+        return true;
+    }
+
+    _canvas = new FrameBufferSurface();
+    if (!_canvas->create(display.width(), display.height(), true, display.getFont())) {
+        ESP_LOGW(TAG, "Page %s: failed to allocate canvas, drawing directly", _pageName.c_str());
+        delete _canvas;
+        _canvas = nullptr;
+        _canvasEnabled = false;
+        return false;
+    }
+    ESP_LOGI(TAG, "Page %s: retained canvas %dx%d (%u bytes)", _pageName.c_str(),
+             (int)_canvas->width(), (int)_canvas->height(), (unsigned)_canvas->bufferLength());
+
+    // 画布是新建的，视图必须完整绘制一次，并整屏合成
+    _rootView->forceRedraw();
+    _composeAll = true;
+    return true;
+}
+
+void Page::releaseCanvas() {
+    if (_canvas != nullptr) {
+        delete _canvas;
+        _canvas = nullptr;
+    }
+    _composeAll = false;
+    _composedRegion.clear();
+}
+
+void Page::composeRect(DrawSurface& display, const Rect& rect) {
+    if (rect.isEmpty()) {
+        return;
     }
+    // 借助目标裁剪区域只传输变化的部分
+    display.setClipRect(rect.x, rect.y, rect.w, rect.h);
+    _canvas->pushSprite(&display, 0, 0);
+    display.clearClipRect();
 }
 
 bool Page::onClick(int16_t x, int16_t y) {
@@ -71,11 +198,12 @@ bool Page::onClick(int16_t x, int16_t y) {
     return false;
 }
 
-void Page::onSwipe(TouchGestureDetector::SwipeDirection direction) {
+void Page::onSwipe(TouchGestureDetector::SwipeDirection direction, int count) {
     // 将滑动事件传递给根视图
-    if (_rootView && _rootView->onSwipe(direction)) {
+    if (_rootView && _rootView->onSwipe(direction, count)) {
         return;
     }    
+    // 合并的多次返回手势只返回一层，避免一次退出多个页面
     onSwipeDispatched(direction);
 }
 
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "../ui_kit/View.h"
+#include "../ui_kit/DirtyRegion.h"
+#include "../ui_kit/ViewArena.h"
+#include "../render/FrameBufferSurface.h"
 #include <memory>
+#include <functional>
 
 #include "PageType.h"
+#include "PageState.h"
 #include "../gestures/TouchGestureDetector.h"
+#include "../jobs/JobScheduler.h"
 
 /**
  * @brief Page基类 - 所有页面的基础
@@ -49,6 +55,15 @@ public:
      */
     void setRootView(View* rootView) { _rootView = rootView; }
 
+    /**
+     * @brief 获取页面的视图内存池
+     * 
+     * onCreate、onRestoreState和runInBackground的完成回调中用new创建的视图都分配在这里，
+     * 页面销毁时一次释放。其他时机创建视图时可以用ViewArena::Scope切换到这里。
+     * @return 视图内存池
+     */
+    ViewArena& getViewArena() { return _viewArena; }
+
     /**
      * @brief 设置页面参数
      * @param params 页面参数
@@ -76,11 +91,53 @@ public:
     virtual void onRestart();
     virtual void onDestroy();
 
+    /**
+     * @brief 页面实例因内存预算被销毁前保存状态（默认不保存）
+     * @param state 输出的状态包
+     */
+    virtual void onSaveState(PageState& state);
+
+    /**
+     * @brief 重建页面后恢复状态（在onCreate之后、onStart之前调用）
+     * @param state 销毁前保存的状态包
+     */
+    virtual void onRestoreState(const PageState& state);
+
+    /**
+     * @brief 页面离开栈顶后是否可以保留实例
+     * 
+     * 占用独占资源（例如服务器）的页面应返回false，离开时直接销毁
+     * @return 可以保留返回true
+     */
+    virtual bool isRetainable() const { return true; }
+
+    /**
+     * @brief 获取离屏画布占用的内存
+     * @return 字节数，没有画布时返回0
+     */
+    size_t getCanvasBytes() const;
+
+    /**
+     * @brief 估算页面在创建之后加载的数据占用的内存（计入PSRAM预算）
+     * 
+     * 页面管理器只统计onCreate前后的空闲内存变化，后台任务异步加载的数据统计不到，
+     * 由持有这类数据的页面自己报告
+     * @return 字节数
+     */
+    virtual size_t estimateRetainedBytes() const { return 0; }
+
     /**
      * @brief 绘制页面内容
      * @param display 显示对象
      */
-    void draw(m5gfx::M5GFX& display);
+    void draw(DrawSurface& display);
+
+    /**
+     * @brief 取出本次绘制产生的脏区域
+     * @param region 输出的脏区域
+     * @return 区域经过帧差分、是精确的变化区域时返回true（此时空区域表示无需刷新）
+     */
+    bool takeDirtyRegion(DirtyRegion& region);
 
     /**
      * @brief 处理点击事件
@@ -90,11 +147,77 @@ public:
      */
     bool onClick(int16_t x, int16_t y);
 
-    void onSwipe(TouchGestureDetector::SwipeDirection direction);
+    /**
+     * @brief 处理滑动事件
+     * @param direction 滑动方向
+     * @param count 连续同向滑动的次数
+     */
+    void onSwipe(TouchGestureDetector::SwipeDirection direction, int count = 1);
+
+    /**
+     * @brief 启用或禁用页面的离屏画布
+     * 
+     * 启用后视图绘制到PSRAM中的4bpp画布上，只把变化的区域合成到屏幕；
+     * 页面恢复时直接从画布重新显示，不再重绘所有视图。
+     * 画布在首次绘制时创建，申请失败时退回直接绘制。
+     * @param enabled 是否启用
+     */
+    void setRetainedCanvasEnabled(bool enabled);
+
+    /**
+     * @brief 检查是否启用了离屏画布
+     * @return 启用返回true，否则返回false
+     */
+    bool isRetainedCanvasEnabled() const { return _canvasEnabled; }
+
+protected:
+    /**
+     * @brief 在后台任务中执行耗时工作，完成后在UI任务中回调
+     * 
+     * 用于onCreate先显示占位视图、再异步加载真实内容。
+     * work不能访问视图；页面销毁后尚未开始的work不再执行，onDone也不再执行。
+     * @param work 后台工作
+     * @param onDone 完成后在UI任务中执行的回调
+     * @return 任务句柄，可用于取消
+     */
+    JobHandle runInBackground(std::function<void()> work, std::function<void()> onDone);
+
+    /**
+     * @brief 获取页面的离屏画布
+     * @return 画布指针，未启用或尚未创建时返回nullptr
+     */
+    FrameBufferSurface* getRetainedCanvas() const { return _canvas; }
+
 private:
     virtual void onSwipeDispatched(TouchGestureDetector::SwipeDirection direction);
+
+    /**
+     * @brief 按需创建离屏画布
+     * @param display 目标显示对象（用于获取尺寸和字体）
+     * @return 画布可用返回true，否则返回false
+     */
+    bool ensureCanvas(DrawSurface& display);
+
+    /**
+     * @brief 释放离屏画布
+     */
+    void releaseCanvas();
+
+    /**
+     * @brief 将画布的指定区域合成到显示对象
+     * @param display 显示对象
+     * @param rect 区域
+     */
+    void composeRect(DrawSurface& display, const Rect& rect);
+
     PageType _pageType;                    ///< 页面类型
     std::string _pageName;                 ///< 页面名称
     View* _rootView = nullptr;             ///< 页面根视图
     std::shared_ptr<void> _params = nullptr; ///< 页面参数
+    FrameBufferSurface* _canvas = nullptr; ///< 离屏画布（PSRAM）
+    bool _canvasEnabled = false;           ///< 是否启用离屏画布
+    bool _composeAll = false;              ///< 下次绘制时整屏合成画布
+    DirtyRegion _composedRegion;           ///< 已合成但尚未推送到屏幕的区域（经过帧差分）
+    std::shared_ptr<void> _lifeToken = std::make_shared<int>(0); ///< 存活标记，页面销毁后后台工作不再回调
+    ViewArena _viewArena;                  ///< 视图内存池，在析构函数释放根视图之后释放
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "PageManager.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "memory/MemoryPolicy.h"
 
 static const char* TAG = "PageManager";
 
@@ -14,13 +16,7 @@ PageManager::PageManager() {
 
 PageManager::~PageManager() {
     // 确保所有页面都被正确销毁
-    while (!_pageStack.empty()) {
-        auto page = std::move(_pageStack.back());
-        _pageStack.pop_back();
-        if (page) {
-            page->onDestroy();
-        }
-    }
+    destroy();
     ESP_LOGI(TAG, "PageManager destroyed");
 }
 
@@ -30,10 +26,24 @@ void PageManager::registerPage(PageType pageType,
     ESP_LOGD(TAG, "Registered page type: %d", static_cast<int>(pageType));
 }
 
-void PageManager::startActivity(PageType pageType, 
-                                std::shared_ptr<void> params) {
+void PageManager::setScreenSize(int16_t width, int16_t height) {
+    _screenWidth = width;
+    _screenHeight = height;
+    ESP_LOGD(TAG, "Screen size: %dx%d", width, height);
+}
+
+std::unique_ptr<Page> PageManager::createPage(PageType pageType) {
     auto it = _pageFactories.find(pageType);
     if (it == _pageFactories.end()) {
+        ESP_LOGE(TAG, "Page type %d not registered", static_cast<int>(pageType));
+        return nullptr;
+    }
+    return it->second();
+}
+
+void PageManager::startActivity(PageType pageType, 
+                                std::shared_ptr<void> params) {
+    if (_pageFactories.find(pageType) == _pageFactories.end()) {
         ESP_LOGE(TAG, "Page type %d not registered", static_cast<int>(pageType));
         return;
     }
@@ -43,26 +53,45 @@ void PageManager::startActivity(PageType pageType,
         pauseCurrentPage();
     }
 
-    // 创建新页面
-    auto newPage = it->second();
-    if (!newPage) {
+    // 查找出栈后保留的同类型页面；参数不同时不能复用，同类型页面可能共享模块状态，先销毁旧实例
+    PageRecord record;
+    for (auto it = _retainedPages.begin(); it != _retainedPages.end(); ++it) {
+        if (it->type != pageType) {
+            continue;
+        }
+        if (params == nullptr && it->params == nullptr) {
+            record = std::move(*it);
+        } else {
+            destroyRecord(*it);
+        }
+        _retainedPages.erase(it);
+        break;
+    }
+    record.type = pageType;
+    record.params = params;
+
+    if (record.page) {
+        // 复用保留的实例，视图树和数据都还在
+        _stats.hits++;
+        record.page->onRestart();
+    } else if (!buildPage(record)) {
         ESP_LOGE(TAG, "Failed to create page type: %d", static_cast<int>(pageType));
         return;
     }
 
-    // 设置页面参数
-    newPage->setParams(params);
-
     // 设置页面生命周期
-    newPage->onCreate();
-    newPage->onStart();
-    newPage->onResume();
+    record.page->onStart();
+    record.page->onResume();
+    record.lifecycle = Lifecycle::Resumed;
+    record.lastUsed = ++_useCounter;
 
     // 将页面压入栈（使用deque的back操作模拟栈行为）
-    _pageStack.push_back(std::move(newPage));
+    _pageStack.push_back(std::move(record));
 
     // 标记页面转换发生，需要重绘
     _pageTransitionOccurred = true;
+    enforceRetentionBudget();
+    MemoryPolicy::logUsage();
     
     ESP_LOGD(TAG, "Started activity: %d", static_cast<int>(pageType));
 }
@@ -73,26 +102,18 @@ void PageManager::goBack() {
         return;
     }
 
-    // 暂停当前页面
-    auto currentPage = std::move(_pageStack.back());
-    _pageStack.pop_back();
-    currentPage->onPause();
-    currentPage->onStop();
-    currentPage->onDestroy();
-
-    ESP_LOGD(TAG, "Destroyed page: %d", static_cast<int>(currentPage->getType()));
+    // 移除当前页面，可保留的页面留待再次打开
+    popTopPage();
 
     // 如果还有页面，恢复上一个页面
     if (!_pageStack.empty()) {
-        auto resumedPage = _pageStack.back().get();
-        resumedPage->onRestart();
-        resumedPage->onStart();
-        resumedPage->onResume();
-        ESP_LOGD(TAG, "Resumed page: %d", static_cast<int>(resumedPage->getType()));
+        activateTop();
     }
 
     // 标记页面转换发生，需要重绘
     _pageTransitionOccurred = true;
+    enforceRetentionBudget();
+    MemoryPolicy::logUsage();
     
     ESP_LOGD(TAG, "Finished goBack operation");
 }
@@ -101,12 +122,10 @@ void PageManager::startActivityClearTop(PageType pageType,
                                        std::shared_ptr<void> params) {
     // 销毁所有页面
     while (!_pageStack.empty()) {
-        auto page = std::move(_pageStack.back());
+        PageRecord record = std::move(_pageStack.back());
         _pageStack.pop_back();
-        page->onPause();
-        page->onStop();
-        page->onDestroy();
-        ESP_LOGD(TAG, "Destroyed page: %d", static_cast<int>(page->getType()));
+        destroyRecord(record);
+        ESP_LOGD(TAG, "Destroyed page: %d", static_cast<int>(record.type));
     }
 
     // 启动新页面
@@ -116,16 +135,32 @@ void PageManager::startActivityClearTop(PageType pageType,
     _pageTransitionOccurred = true;
 }
 
-void PageManager::draw(m5gfx::M5GFX& display) {
-    if (!_pageStack.empty()) {
-        auto currentPage = _pageStack.back().get();
+void PageManager::draw(DrawSurface& display) {
+    if (auto currentPage = getCurrentPage()) {
         currentPage->draw(display);
     }
 }
 
+bool PageManager::takeDirtyRegion(DirtyRegion& region) {
+    region.clear();
+    bool exact = false;
+    auto currentPage = getCurrentPage();
+    if (currentPage) {
+        // 即使整屏刷新也要取出，避免旧区域累积到下一帧
+        exact = currentPage->takeDirtyRegion(region);
+    }
+
+    if (_pageTransitionOccurred || currentPage == nullptr) {
+        _pageTransitionOccurred = false;
+        region.clear();
+        return true;
+    }
+    // 有绘制但没有记录到区域时保守地整屏刷新；精确区域为空说明像素没有变化
+    return region.isEmpty() && !exact;
+}
+
 bool PageManager::onClick(int16_t x, int16_t y) {
-    if (!_pageStack.empty()) {
-        auto currentPage = _pageStack.back().get();
+    if (auto currentPage = getCurrentPage()) {
         return currentPage->onClick(x, y);
     }
     return false;
@@ -133,14 +168,13 @@ bool PageManager::onClick(int16_t x, int16_t y) {
 
 Page* PageManager::getCurrentPage() {
     if (!_pageStack.empty()) {
-        return _pageStack.back().get();
+        return _pageStack.back().page.get();
     }
     return nullptr;
 }
 
 std::string PageManager::getCurrentPageName() {
-    if (!_pageStack.empty()) {
-        auto currentPage = _pageStack.back().get();
+    if (auto currentPage = getCurrentPage()) {
         return currentPage->getName();
     }
     return "";
@@ -148,8 +182,8 @@ std::string PageManager::getCurrentPageName() {
 
 bool PageManager::isPageInStack(PageType pageType) const {
     // 使用deque的迭代能力来检查页面类型
-    for (const auto& page : _pageStack) {
-        if (page && page->getType() == pageType) {
+    for (const auto& record : _pageStack) {
+        if (record.type == pageType) {
             return true;
         }
     }
@@ -159,8 +193,8 @@ bool PageManager::isPageInStack(PageType pageType) const {
 size_t PageManager::getPageCountByType(PageType pageType) const {
     size_t count = 0;
     // 使用deque的迭代能力来统计页面类型
-    for (const auto& page : _pageStack) {
-        if (page && page->getType() == pageType) {
+    for (const auto& record : _pageStack) {
+        if (record.type == pageType) {
             count++;
         }
     }
@@ -168,9 +202,13 @@ size_t PageManager::getPageCountByType(PageType pageType) const {
 }
 
 void PageManager::pauseCurrentPage() {
-    if (!_pageStack.empty()) {
-        auto currentPage = _pageStack.back().get();
-        currentPage->onPause();
+    if (_pageStack.empty()) {
+        return;
+    }
+    PageRecord& top = _pageStack.back();
+    if (top.page && top.lifecycle == Lifecycle::Resumed) {
+        top.page->onPause();
+        top.lifecycle = Lifecycle::Paused;
     }
 }
 
@@ -194,36 +232,30 @@ void PageManager::destroyPage(Page* page) {
 
 void PageManager::destroy() {
     while (!_pageStack.empty()) {
-        auto page = std::move(_pageStack.back());
+        PageRecord record = std::move(_pageStack.back());
         _pageStack.pop_back();
-        if (page) {
-            page->onDestroy();
+        if (record.page) {
+            record.page->onDestroy();
         }
     }
+    while (!_retainedPages.empty()) {
+        destroyRecord(_retainedPages.back());
+        _retainedPages.pop_back();
+    }
 }
 
 void PageManager::finishActivity() {
     if (!_pageStack.empty()) {
-        // 获取当前页面
-        auto currentPage = _pageStack.back().get();
-        
-        // 执行页面生命周期方法
-        currentPage->onPause();
-        currentPage->onStop();
-        currentPage->onDestroy();
-        
-        // 从页面栈中移除页面
-        _pageStack.pop_back();
+        // 移除当前页面，可保留的页面留待再次打开
+        popTopPage();
         
         // 如果还有页面在栈中，恢复前一个页面
         if (!_pageStack.empty()) {
-            auto previousPage = _pageStack.back().get();
-            previousPage->onRestart();
-            previousPage->onStart();
-            previousPage->onResume();
+            activateTop();
         }
         
         _pageTransitionOccurred = true;
+        enforceRetentionBudget();
         ESP_LOGD("PageManager", "Finished current activity, stack size: %zu", _pageStack.size());
     } else {
         ESP_LOGW("PageManager", "No activity to finish");
@@ -245,9 +277,197 @@ bool PageManager::isDirty() {
     return result;
 }
 
-void PageManager::onSwipe(TouchGestureDetector::SwipeDirection direction) {
-    if (!_pageStack.empty()) {
-        auto currentPage = _pageStack.back().get();
-        currentPage->onSwipe(direction);
+void PageManager::onSwipe(TouchGestureDetector::SwipeDirection direction, int count) {
+    if (auto currentPage = getCurrentPage()) {
+        currentPage->onSwipe(direction, count);
+    }
+}
+
+void PageManager::setRetentionBudget(size_t internalBytes, size_t psramBytes) {
+    _internalBudget = internalBytes;
+    _psramBudget = psramBytes;
+    enforceRetentionBudget();
+}
+
+PageManager::RetentionStats PageManager::getRetentionStats() const {
+    RetentionStats stats = _stats;
+    stats.internalBytes = 0;
+    stats.psramBytes = 0;
+    auto accumulate = [&stats](const PageRecord& record) {
+        if (record.page) {
+            stats.internalBytes += record.internalBytes;
+            // 异步加载的数据不在创建时的统计中，由页面自己估算
+            stats.psramBytes += record.psramBytes + record.page->getCanvasBytes() + record.page->estimateRetainedBytes();
+        }
+    };
+    for (size_t i = 0; i + 1 < _pageStack.size(); i++) {
+        accumulate(_pageStack[i]);
+    }
+    for (const PageRecord& record : _retainedPages) {
+        accumulate(record);
+    }
+    return stats;
+}
+
+bool PageManager::buildPage(PageRecord& record) {
+    size_t internalBefore = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psramBefore = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    record.page = createPage(record.type);
+    if (!record.page) {
+        return false;
     }
+    _stats.misses++;
+    record.page->setParams(record.params);
+    {
+        // 视图树建在页面自己的内存池中，按同类页面上次的高水位一次预留
+        ViewArena& arena = record.page->getViewArena();
+        arena.reserve(getViewArenaHighWater(record.type));
+        ViewArena::Scope scope(arena);
+        record.page->onCreate();
+        if (!record.state.isEmpty()) {
+            // 之前被裁剪过，恢复到裁剪前的状态
+            record.page->onRestoreState(record.state);
+            record.state.clear();
+            _stats.restores++;
+        }
+    }
+    noteViewArena(record);
+
+    // 用创建前后的空闲内存估算页面占用（离屏画布在首次绘制时创建，单独统计）
+    size_t internalAfter = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psramAfter = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    record.internalBytes = internalBefore > internalAfter ? internalBefore - internalAfter : 0;
+    record.psramBytes = psramBefore > psramAfter ? psramBefore - psramAfter : 0;
+    return true;
+}
+
+void PageManager::activateTop() {
+    while (!_pageStack.empty()) {
+        PageRecord& top = _pageStack.back();
+        if (top.page) {
+            top.page->onRestart();
+        } else if (!buildPage(top)) {
+            // 无法重建时跳过这个页面，继续返回
+            ESP_LOGE(TAG, "Failed to rebuild page type: %d", static_cast<int>(top.type));
+            _pageStack.pop_back();
+            continue;
+        }
+        top.page->onStart();
+        top.page->onResume();
+        top.lifecycle = Lifecycle::Resumed;
+        top.lastUsed = ++_useCounter;
+        ESP_LOGD(TAG, "Resumed page: %d", static_cast<int>(top.type));
+        return;
+    }
+}
+
+void PageManager::popTopPage() {
+    PageRecord record = std::move(_pageStack.back());
+    _pageStack.pop_back();
+    if (!record.page) {
+        return;
+    }
+    if (record.lifecycle == Lifecycle::Resumed) {
+        record.page->onPause();
+    }
+    record.page->onStop();
+    record.lifecycle = Lifecycle::Stopped;
+    if (!record.page->isRetainable()) {
+        destroyRecord(record);
+        ESP_LOGD(TAG, "Destroyed page: %d", static_cast<int>(record.type));
+        return;
+    }
+
+    // 每种类型只保留一个实例
+    for (auto it = _retainedPages.begin(); it != _retainedPages.end(); ++it) {
+        if (it->type == record.type) {
+            destroyRecord(*it);
+            _retainedPages.erase(it);
+            break;
+        }
+    }
+    _retainedPages.push_back(std::move(record));
+    while (_retainedPages.size() > MAX_RETAINED_PAGES) {
+        destroyRecord(_retainedPages.front());
+        _retainedPages.pop_front();
+    }
+    ESP_LOGD(TAG, "Retained page: %d", static_cast<int>(_retainedPages.back().type));
+}
+
+void PageManager::trimRecord(PageRecord& record) {
+    record.state.clear();
+    record.page->onSaveState(record.state);
+    destroyRecord(record);
+    _stats.trims++;
+    ESP_LOGI(TAG, "Trimmed page %d to its state bundle", static_cast<int>(record.type));
+}
+
+void PageManager::destroyRecord(PageRecord& record) {
+    if (!record.page) {
+        return;
+    }
+    // 被覆盖的栈中页面已经暂停过，只补上onStop
+    if (record.lifecycle == Lifecycle::Resumed) {
+        record.page->onPause();
+    }
+    if (record.lifecycle != Lifecycle::Stopped) {
+        record.page->onStop();
+    }
+    record.page->onDestroy();
+    noteViewArena(record);
+    record.page.reset();
+    record.internalBytes = 0;
+    record.psramBytes = 0;
+}
+
+void PageManager::noteViewArena(const PageRecord& record) {
+    ViewArena::Stats arena = record.page->getViewArena().getStats();
+    size_t& highWater = _viewArenaHighWater[record.type];
+    if (arena.used > highWater) {
+        highWater = arena.used;
+    }
+#if VIEW_ARENA_DEBUG
+    ESP_LOGI(TAG, "View arena %s (type %d): used %u / %u bytes in %u block(s), high-water %u",
+             record.page->getName().c_str(), static_cast<int>(record.type), (unsigned)arena.used,
+             (unsigned)arena.capacity, (unsigned)arena.blocks, (unsigned)highWater);
+#endif
+}
+
+size_t PageManager::getViewArenaHighWater(PageType type) const {
+    auto it = _viewArenaHighWater.find(type);
+    return it != _viewArenaHighWater.end() ? it->second : 0;
+}
+
+void PageManager::enforceRetentionBudget() {
+    while (true) {
+        RetentionStats usage = getRetentionStats();
+        bool lowMemory = heap_caps_get_free_size(MALLOC_CAP_INTERNAL) < MIN_FREE_INTERNAL;
+        if (!lowMemory && usage.internalBytes <= _internalBudget && usage.psramBytes <= _psramBudget) {
+            break;
+        }
+
+        // 找出最久没有显示过的保留页面（栈顶页面不参与）
+        PageRecord* victim = nullptr;
+        for (size_t i = 0; i + 1 < _pageStack.size(); i++) {
+            PageRecord& record = _pageStack[i];
+            if (record.page && (victim == nullptr || record.lastUsed < victim->lastUsed)) {
+                victim = &record;
+            }
+        }
+        for (PageRecord& record : _retainedPages) {
+            if (record.page && (victim == nullptr || record.lastUsed < victim->lastUsed)) {
+                victim = &record;
+            }
+        }
+        if (victim == nullptr) {
+            break;
+        }
+        trimRecord(*victim);
+    }
+
+    RetentionStats stats = getRetentionStats();
+    ESP_LOGD(TAG, "Page retention: hits=%u misses=%u restores=%u trims=%u, internal=%u psram=%u",
+             (unsigned)stats.hits, (unsigned)stats.misses, (unsigned)stats.restores, (unsigned)stats.trims,
+             (unsigned)stats.internalBytes, (unsigned)stats.psramBytes);
 }
\ No newline at end of file
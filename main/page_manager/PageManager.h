@@ -10,10 +10,29 @@
 /**
  * @brief 页面管理器 - 管理页面栈和页面生命周期
  * 
- * 类似Android的Activity管理机制，负责页面的创建、切换和生命周期管理
+ * 类似Android的Activity管理机制，负责页面的创建、切换和生命周期管理。
+ * 离开栈顶的页面（包括返回后出栈的页面）保留视图树和数据，再次显示时不必重建；
+ * 保留页面的内存超出预算或内部RAM不足时，按最近最少使用的顺序裁剪为状态包，需要时再重建。
  */
 class PageManager {
 public:
+    static const size_t DEFAULT_INTERNAL_BUDGET = 48 * 1024;        ///< 保留页面默认可占用的内部RAM
+    static const size_t DEFAULT_PSRAM_BUDGET = 2 * 1024 * 1024;     ///< 保留页面默认可占用的PSRAM
+    static const size_t MIN_FREE_INTERNAL = 32 * 1024;              ///< 内部RAM低于该值时裁剪所有保留页面
+    static const size_t MAX_RETAINED_PAGES = 4;                     ///< 出栈后保留的页面数量上限
+
+    /**
+     * @brief 页面保留统计
+     */
+    struct RetentionStats {
+        uint32_t hits = 0;      ///< 直接复用保留实例的次数
+        uint32_t misses = 0;    ///< 需要新建页面的次数
+        uint32_t restores = 0;  ///< 新建后从状态包恢复的次数（包含在misses中）
+        uint32_t trims = 0;     ///< 因预算裁剪页面实例的次数
+        size_t internalBytes = 0;  ///< 当前保留页面占用的内部RAM（估算）
+        size_t psramBytes = 0;     ///< 当前保留页面占用的PSRAM（估算）
+    };
+
     /**
      * @brief 获取单例实例
      * @return PageManager单例实例引用
@@ -42,6 +61,35 @@ public:
     void registerPage(PageType pageType, 
                       std::function<std::unique_ptr<Page>()> factory);
 
+    /**
+     * @brief 设置页面使用的屏幕尺寸
+     * 
+     * 页面按这个尺寸创建根视图，不直接访问显示设备；
+     * 设备上在M5.begin之后设置，主机构建中设置为内存帧缓冲的尺寸
+     * @param width 屏幕宽度
+     * @param height 屏幕高度
+     */
+    void setScreenSize(int16_t width, int16_t height);
+
+    /**
+     * @brief 获取屏幕宽度
+     * @return 屏幕宽度
+     */
+    int16_t getScreenWidth() const { return _screenWidth; }
+
+    /**
+     * @brief 获取屏幕高度
+     * @return 屏幕高度
+     */
+    int16_t getScreenHeight() const { return _screenHeight; }
+
+    /**
+     * @brief 使用注册的工厂函数创建页面（不进入页面栈，不调用生命周期方法）
+     * @param pageType 页面类型
+     * @return 页面实例，未注册或创建失败时返回nullptr
+     */
+    std::unique_ptr<Page> createPage(PageType pageType);
+
     /**
      * @brief 启动指定页面
      * @param pageType 页面类型
@@ -67,7 +115,17 @@ public:
      * @brief 绘制当前页面
      * @param display 显示对象
      */
-    void draw(m5gfx::M5GFX& display);
+    void draw(DrawSurface& display);
+
+    /**
+     * @brief 取出需要推送到屏幕的脏区域
+     * 
+     * 页面切换后需要整屏刷新，此时不输出区域；
+     * 返回false且区域为空表示像素没有变化，无需刷新
+     * @param region 输出的脏区域
+     * @return 需要整屏刷新时返回true
+     */
+    bool takeDirtyRegion(DirtyRegion& region);
 
     /**
      * @brief 处理点击事件
@@ -131,9 +189,97 @@ public:
      */
     bool isDirty();
 
-    void onSwipe(TouchGestureDetector::SwipeDirection direction);
+    /**
+     * @brief 处理滑动事件
+     * @param direction 滑动方向
+     * @param count 连续同向滑动的次数
+     */
+    void onSwipe(TouchGestureDetector::SwipeDirection direction, int count = 1);
+
+    /**
+     * @brief 设置保留页面的内存预算
+     * @param internalBytes 可占用的内部RAM
+     * @param psramBytes 可占用的PSRAM
+     */
+    void setRetentionBudget(size_t internalBytes, size_t psramBytes);
+
+    /**
+     * @brief 获取页面保留统计
+     * @return 统计信息
+     */
+    RetentionStats getRetentionStats() const;
+
+    /**
+     * @brief 获取某类页面视图内存池的高水位
+     * @param type 页面类型
+     * @return 字节数，该类页面尚未创建过时返回0
+     */
+    size_t getViewArenaHighWater(PageType type) const;
 
 private:
+    /**
+     * @brief 页面实例所处的生命周期阶段
+     */
+    enum class Lifecycle : uint8_t {
+        Resumed,  ///< 位于栈顶，已执行onResume
+        Paused,   ///< 被新页面覆盖，已执行onPause
+        Stopped,  ///< 已出栈并保留，已执行onStop
+    };
+
+    /**
+     * @brief 页面记录：页面实例及其被裁剪后保留的状态
+     */
+    struct PageRecord {
+        PageType type = PageType::UNKNOWN;     ///< 页面类型
+        std::unique_ptr<Page> page;            ///< 页面实例，被裁剪后为nullptr
+        std::shared_ptr<void> params;          ///< 页面参数
+        PageState state;                       ///< 被裁剪时保存的状态
+        size_t internalBytes = 0;              ///< 创建时占用的内部RAM（估算）
+        size_t psramBytes = 0;                 ///< 创建时占用的PSRAM（估算）
+        uint32_t lastUsed = 0;                 ///< 最近一次位于栈顶的序号
+        Lifecycle lifecycle = Lifecycle::Resumed; ///< 页面实例的生命周期阶段
+    };
+
+    /**
+     * @brief 创建页面实例并执行onCreate，有状态包时恢复状态
+     * @param record 页面记录
+     * @return 成功返回true
+     */
+    bool buildPage(PageRecord& record);
+
+    /**
+     * @brief 让栈顶页面重新进入前台（实例被裁剪时重建）
+     */
+    void activateTop();
+
+    /**
+     * @brief 移除栈顶页面，可保留的页面放入保留列表
+     */
+    void popTopPage();
+
+    /**
+     * @brief 保存状态并销毁页面实例，只保留状态包
+     * @param record 页面记录
+     */
+    void trimRecord(PageRecord& record);
+
+    /**
+     * @brief 超出内存预算时按最近最少使用的顺序裁剪保留的页面
+     */
+    void enforceRetentionBudget();
+
+    /**
+     * @brief 销毁页面记录中的实例，按记录的生命周期阶段补齐尚未执行的onPause/onStop
+     * @param record 页面记录
+     */
+    void destroyRecord(PageRecord& record);
+
+    /**
+     * @brief 记录页面视图内存池的高水位，下次创建同类页面时一次预留
+     * @param record 页面记录
+     */
+    void noteViewArena(const PageRecord& record);
+
     /**
      * @brief 暂停当前页面
      */
@@ -158,6 +304,14 @@ private:
     void destroyPage(Page* page);
 
     std::unordered_map<PageType, std::function<std::unique_ptr<Page>()>> _pageFactories;  ///< 页面工厂映射表
-    std::deque<std::unique_ptr<Page>> _pageStack;  ///< 页面栈（使用deque实现，支持遍历）
+    std::deque<PageRecord> _pageStack;      ///< 页面栈（使用deque实现，支持遍历）
+    std::deque<PageRecord> _retainedPages;  ///< 出栈后保留的页面（已停止，最近使用的在后）
     bool _pageTransitionOccurred = false;  ///< 页面转换标志
+    int16_t _screenWidth = 0;              ///< 屏幕宽度
+    int16_t _screenHeight = 0;             ///< 屏幕高度
+    size_t _internalBudget = DEFAULT_INTERNAL_BUDGET;  ///< 保留页面的内部RAM预算
+    size_t _psramBudget = DEFAULT_PSRAM_BUDGET;        ///< 保留页面的PSRAM预算
+    uint32_t _useCounter = 0;                          ///< 最近使用序号
+    RetentionStats _stats;                             ///< 页面保留统计
+    std::unordered_map<PageType, size_t> _viewArenaHighWater;  ///< 各类页面视图内存池的高水位
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief 页面状态包 - 页面被裁剪时保存的少量状态
+ * 
+ * 页面实例因内存预算被销毁后只保留状态包，重新显示时由新实例恢复，
+ * 例如文件浏览器的当前路径和页码。只适合保存少量简单数据。
+ */
+class PageState {
+public:
+    /**
+     * @brief 保存字符串
+     * @param key 键
+     * @param value 值
+     */
+    void putString(const std::string& key, const std::string& value) { _strings[key] = value; }
+
+    /**
+     * @brief 保存整数
+     * @param key 键
+     * @param value 值
+     */
+    void putInt(const std::string& key, int32_t value) { _ints[key] = value; }
+
+    /**
+     * @brief 读取字符串
+     * @param key 键
+     * @param defaultValue 不存在时返回的值
+     * @return 保存的值
+     */
+    std::string getString(const std::string& key, const std::string& defaultValue = "") const {
+        auto it = _strings.find(key);
+        return it != _strings.end() ? it->second : defaultValue;
+    }
+
+    /**
+     * @brief 读取整数
+     * @param key 键
+     * @param defaultValue 不存在时返回的值
+     * @return 保存的值
+     */
+    int32_t getInt(const std::string& key, int32_t defaultValue = 0) const {
+        auto it = _ints.find(key);
+        return it != _ints.end() ? it->second : defaultValue;
+    }
+
+    /**
+     * @brief 是否没有保存任何状态
+     */
+    bool isEmpty() const { return _strings.empty() && _ints.empty(); }
+
+    /**
+     * @brief 清空状态
+     */
+    void clear() {
+        _strings.clear();
+        _ints.clear();
+    }
+
+private:
+    std::unordered_map<std::string, std::string> _strings;  ///< 字符串值
+    std::unordered_map<std::string, int32_t> _ints;         ///< 整数值
+};
\ No newline at end of file
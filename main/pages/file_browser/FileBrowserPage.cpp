@@ -21,8 +21,8 @@ void FileBrowserPage::onCreate() {
     ESP_LOGI(TAG, "FileBrowserPage onCreate");
     
     // 创建主布局
-    auto screenWidth = M5.Display.width();
-    auto screenHeight = M5.Display.height();
+    auto screenWidth = PageManager::getInstance().getScreenWidth();
+    auto screenHeight = PageManager::getInstance().getScreenHeight();
     _layout = new LinearLayout(screenWidth, screenHeight);
     _layout->setOrientation(LinearLayout::Orientation::VERTICAL);
     Button *backButton = new Button(100, 40);
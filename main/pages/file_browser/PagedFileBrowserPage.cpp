@@ -10,6 +10,8 @@ static const char* TAG = "PagedFileBrowserPage";
 PagedFileBrowserPage::PagedFileBrowserPage() 
     : Page(PageType::FILE_BROWSER, "PagedFileBrowser"), _layout(nullptr) {
     ESP_LOGI(TAG, "PagedFileBrowserPage constructed");
+    // 返回该页面的频率很高，保留离屏画布以免每次重绘全部视图
+    setRetainedCanvasEnabled(true);
 }
 
 PagedFileBrowserPage::~PagedFileBrowserPage() {
@@ -22,8 +24,8 @@ void PagedFileBrowserPage::onCreate() {
     ESP_LOGI(TAG, "PagedFileBrowserPage onCreate");
     
     // 创建主布局
-    auto screenWidth = M5.Display.width();
-    auto screenHeight = M5.Display.height();
+    auto screenWidth = PageManager::getInstance().getScreenWidth();
+    auto screenHeight = PageManager::getInstance().getScreenHeight();
     _layout = new LinearLayout(screenWidth, screenHeight);
     _layout->setOrientation(LinearLayout::Orientation::VERTICAL);
     
@@ -36,7 +38,7 @@ void PagedFileBrowserPage::onCreate() {
     // titleView->setPadding(10, 10, 10, 10);
     // _layout->addChild(titleView);
     
-    // 初始化分页文件浏览器（现在底部控制栏由PagedListView自己处理）
+    // 初始化分页文件浏览器（现在底部控制栏由PagedListView自己处理，目录内容异步加载）
     paged_file_browser_init(_layout);
     
     // 设置返回回调
@@ -80,4 +82,27 @@ void PagedFileBrowserPage::onDestroy() {
     paged_file_browser_deinit();
     
     Page::onDestroy();
+}
+
+void PagedFileBrowserPage::onSaveState(PageState& state) {
+    const char* path = paged_file_browser_get_current_path();
+    if (path != nullptr) {
+        state.putString("path", path);
+    }
+    state.putInt("page", paged_file_browser_get_current_page());
+    Page::onSaveState(state);
+}
+
+void PagedFileBrowserPage::onRestoreState(const PageState& state) {
+    std::string path = state.getString("path");
+    const char* currentPath = paged_file_browser_get_current_path();
+    if (!path.empty() && (currentPath == nullptr || path != currentPath)) {
+        paged_file_browser_open_directory(path.c_str());
+    }
+    paged_file_browser_set_current_page(state.getInt("page"));
+    Page::onRestoreState(state);
+}
+
+size_t PagedFileBrowserPage::estimateRetainedBytes() const {
+    return paged_file_browser_get_memory_usage();
 }
\ No newline at end of file
@@ -50,6 +50,21 @@ public:
      */
     void onDestroy() override;
 
+    /**
+     * @brief 保存当前目录和页码
+     */
+    void onSaveState(PageState& state) override;
+
+    /**
+     * @brief 恢复到保存的目录和页码
+     */
+    void onRestoreState(const PageState& state) override;
+
+    /**
+     * @brief 异步加载的目录项和名称池占用的内存
+     */
+    size_t estimateRetainedBytes() const override;
+
 private:
     LinearLayout* _layout;  ///< 页面布局
 };
\ No newline at end of file
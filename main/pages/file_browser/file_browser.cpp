@@ -1,5 +1,6 @@
 #include "file_browser.h"
 #include "ui_kit/UIKIT.h"
+#include "hal/sdcard/DirectoryScanner.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
@@ -51,19 +52,10 @@ static bool is_allowed_file_type(const char *filename) {
 }
 
 /**
- * @brief 比较函数，用于排序目录项（目录在前，文件在后，按字母顺序）
+ * @brief 目录扫描过滤器：保留目录和允许的文件类型
  */
-static bool compare_entries(const std::pair<std::string, std::string>& a, const std::pair<std::string, std::string>& b) {
-    struct stat st_a, st_b;
-    bool is_dir_a = (stat(a.second.c_str(), &st_a) == 0 && S_ISDIR(st_a.st_mode));
-    bool is_dir_b = (stat(b.second.c_str(), &st_b) == 0 && S_ISDIR(st_b.st_mode));
-    
-    // 目录优先于文件
-    if (is_dir_a && !is_dir_b) return true;
-    if (!is_dir_a && is_dir_b) return false;
-    
-    // 同类型按名称排序
-    return a.first < b.first;
+static bool is_listed_entry(const char *name, bool is_directory) {
+    return is_directory || is_allowed_file_type(name);
 }
 
 /**
@@ -71,54 +63,17 @@ static bool compare_entries(const std::pair<std::string, std::string>& a, const
  * @param path 目录路径
  */
 static void load_directory_content(const char *path) {
-    DIR *dir;
-    struct dirent *entry;
-    
     // 清空现有列表
     g_file_browser.file_items.clear();
     g_file_browser.file_full_paths.clear();
     g_file_browser.is_directory.clear();
     
-    dir = opendir(path);
-    if (dir == NULL) {
-        ESP_LOGE(TAG, "Cannot open directory: %s", path);
+    // 一次遍历收集并排序目录项，类型来自d_type，排序不再访问SD卡
+    DirectoryListing listing;
+    if (!DirectoryScanner::scan(path, listing, is_listed_entry)) {
         return;
     }
     
-    // 收集所有符合条件的目录项
-    std::vector<std::pair<std::string, std::string>> entries; // {name, full_path}
-    
-    while ((entry = readdir(dir)) != NULL) {
-        // 跳过当前目录和父目录
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-        
-        // 检查路径长度以避免溢出
-        int len_path = strlen(path);
-        int len_entry = strlen(entry->d_name);
-        if (len_path + 1 + len_entry >= MAX_PATH_LEN) {
-            continue; // 跳过过长的路径
-        }
-        
-        char full_path[MAX_PATH_LEN];
-        strcpy(full_path, path);
-        strcat(full_path, "/");
-        strcat(full_path, entry->d_name);
-        
-        struct stat st;
-        if (stat(full_path, &st) == 0) {
-            if (S_ISDIR(st.st_mode) || is_allowed_file_type(entry->d_name)) {
-                entries.push_back(std::make_pair(std::string(entry->d_name), std::string(full_path)));
-            }
-        }
-    }
-    
-    closedir(dir);
-    
-    // 排序目录项
-    std::sort(entries.begin(), entries.end(), compare_entries);
-    
     // 添加返回上级目录选项（如果不是根目录）
     if (strcmp(path, "/sdcard/books") != 0) {
         char parent_path[MAX_PATH_LEN];
@@ -136,17 +91,13 @@ static void load_directory_content(const char *path) {
     }
     
     // 添加所有目录项到列表
-    for (auto& entry : entries) {
-        struct stat st;
-        bool is_dir = (stat(entry.second.c_str(), &st) == 0 && S_ISDIR(st.st_mode));
-        
-        std::string display_name = entry.first;
-        if (is_dir) {
-            display_name = "[DIR] " + display_name;
-        }
+    for (size_t i = 0; i < listing.size(); i++) {
+        bool is_dir = listing[i].isDirectory;
+        std::string display_name = is_dir ? "[DIR] " : "";
+        display_name += listing.nameAt(i);
         ESP_LOGD("FileBrowser", "display_name: %s", display_name.c_str());
         g_file_browser.file_items.push_back(display_name);
-        g_file_browser.file_full_paths.push_back(entry.second);
+        g_file_browser.file_full_paths.push_back(listing.fullPathAt(i));
         g_file_browser.is_directory.push_back(is_dir);
     }
     
@@ -1,6 +1,11 @@
 #include "paged_file_browser.h"
 #include "ui_kit/UIKIT.h"
 #include "ui_kit/PagedListView.h"
+#include "ui_kit/TextEllipsizer.h"
+#include "jobs/JobScheduler.h"
+#include "hal/sdcard/DirectoryScanner.h"
+#include "hal/sdcard/DirectoryIndex.h"
+#include "hal/sdcard/sdcard.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
@@ -10,6 +15,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <memory>
 
 static const char *TAG = "PagedFileBrowser";
 
@@ -19,6 +25,8 @@ static const char *TAG = "PagedFileBrowser";
 #define PAGE_SIZE 6
 // 显示的文件名最大长度
 #define MAX_DISPLAY_NAME_LEN 64
+// 目录索引的过滤器标识，is_listed_entry的规则变化时需要修改
+#define INDEX_FILTER_TAG 0x54585045  // "EPXT"
 
 // 分页文件浏览器状态结构
 typedef struct {
@@ -26,12 +34,23 @@ typedef struct {
     LinearLayout* screen_layout;
     PagedListView* file_paged_list_view;
     TextView* title_view;
-    std::vector<std::string> all_file_items;          // 存储所有文件/目录项
-    std::vector<std::string> all_file_full_paths;     // 存储所有完整路径
-    std::vector<bool> all_is_directory;               // 标记是否为目录
+    TextView* loading_view;                           // 首次加载完成前显示的占位视图
+    std::shared_ptr<DirectoryListing> entries;        // 当前目录的目录项（名称池，优先放在PSRAM中）
+    bool has_parent_entry;                            // 列表第一项是否为返回上级目录
 } paged_file_browser_t;
 
+// 后台加载结果
+typedef struct {
+    std::string path;                                 // 加载的目录
+    std::shared_ptr<DirectoryListing> listing;        // 目录项
+    DirectoryIndex::LoadResult index;                 // 目录索引的读取结果
+    bool streamed;                                    // 是否已经分批显示过
+} directory_load_t;
+
 static paged_file_browser_t g_paged_file_browser = {};
+static JobHandle g_load_job;                          // 正在进行的目录扫描任务
+static JobHandle g_verify_job;                        // 正在进行的目录索引校验任务
+static int g_pending_page = -1;                       // 目录加载完成后要跳转的页码
 static SemaphoreHandle_t paged_file_browser_mutex = NULL;
 
 // 回调函数指针定义
@@ -54,112 +73,200 @@ static bool is_allowed_file_type(const char *filename) {
 }
 
 /**
- * @brief 比较函数，用于排序目录项（目录在前，文件在后，按字母顺序）
+ * @brief 目录扫描过滤器：保留目录和允许的文件类型
  */
-static bool compare_entries(const std::pair<std::string, std::string>& a, const std::pair<std::string, std::string>& b) {
-    struct stat st_a, st_b;
-    bool is_dir_a = (stat(a.second.c_str(), &st_a) == 0 && S_ISDIR(st_a.st_mode));
-    bool is_dir_b = (stat(b.second.c_str(), &st_b) == 0 && S_ISDIR(st_b.st_mode));
-    
-    // 目录优先于文件
-    if (is_dir_a && !is_dir_b) return true;
-    if (!is_dir_a && is_dir_b) return false;
-    
-    // 同类型按名称排序
-    return a.first < b.first;
+static bool is_listed_entry(const char *name, bool is_directory) {
+    return is_directory || is_allowed_file_type(name);
 }
 
 /**
- * @brief 加载目录内容到列表
+ * @brief 目录是否有返回上级目录选项（根目录没有）
  * @param path 目录路径
  */
-static void load_directory_content(const char *path) {
-    DIR *dir;
-    struct dirent *entry;
-    
-    // 清空现有列表
-    g_paged_file_browser.all_file_items.clear();
-    g_paged_file_browser.all_file_full_paths.clear();
-    g_paged_file_browser.all_is_directory.clear();
-    
-    dir = opendir(path);
-    if (dir == NULL) {
-        ESP_LOGE(TAG, "Cannot open directory: %s", path);
-        return;
+static bool path_has_parent(const std::string& path) {
+    return path != SDCARD_BOOKS_DIR;
+}
+
+/**
+ * @brief 计算上级目录路径
+ * @param path 目录路径
+ * @return 上级目录路径
+ */
+static std::string parent_path_of(const std::string& path) {
+    size_t last_slash = path.rfind('/');
+    if (last_slash == std::string::npos || last_slash == 0) {
+        return "/"; // 根目录情况
     }
+    return path.substr(0, last_slash);
+}
+
+/**
+ * @brief 替换当前显示的目录项（在UI任务中调用）
+ * @param entries 目录项
+ */
+static void set_directory_entries(std::shared_ptr<DirectoryListing> entries) {
+    g_paged_file_browser.has_parent_entry = entries && path_has_parent(entries->path());
+    g_paged_file_browser.entries = std::move(entries);
+}
+
+/**
+ * @brief 把目录项显示到列表（在UI任务中调用）
+ * @param entries 排序好的目录项，之后不能再在其他任务中修改
+ */
+static void apply_directory_content(std::shared_ptr<DirectoryListing> entries) {
+    set_directory_entries(std::move(entries));
     
-    // 收集所有符合条件的目录项
-    std::vector<std::pair<std::string, std::string>> entries; // {name, full_path}
-    
-    while ((entry = readdir(dir)) != NULL) {
-        // 跳过当前目录和父目录
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-        
-        // 检查路径长度以避免溢出
-        int len_path = strlen(path);
-        int len_entry = strlen(entry->d_name);
-        if (len_path + 1 + len_entry >= MAX_PATH_LEN) {
-            continue; // 跳过过长的路径
-        }
-        
-        char full_path[MAX_PATH_LEN];
-        strcpy(full_path, path);
-        strcat(full_path, "/");
-        strcat(full_path, entry->d_name);
-        
-        struct stat st;
-        if (stat(full_path, &st) == 0) {
-            if (S_ISDIR(st.st_mode) || is_allowed_file_type(entry->d_name)) {
-                entries.push_back(std::make_pair(std::string(entry->d_name), std::string(full_path)));
-            }
-        }
+    // 内容已就绪，用列表替换加载提示
+    if (g_paged_file_browser.loading_view) {
+        g_paged_file_browser.loading_view->setVisibility(View::GONE);
     }
     
-    closedir(dir);
-    
-    // 排序目录项
-    std::sort(entries.begin(), entries.end(), compare_entries);
-    
-    // 添加返回上级目录选项（如果不是根目录）
-    if (strcmp(path, "/sdcard/books") != 0) {
-        char parent_path[MAX_PATH_LEN];
-        strcpy(parent_path, path);
-        char *last_slash = strrchr(parent_path, '/');
-        if (last_slash && last_slash != parent_path) {
-            *(last_slash) = '\0';
-        } else {
-            strcpy(parent_path, "/"); // 根目录情况
+    // 如果分页列表视图已存在，通知它重新加载数据
+    if (g_paged_file_browser.file_paged_list_view) {
+        g_paged_file_browser.file_paged_list_view->setVisibility(View::VISIBLE);
+        g_paged_file_browser.file_paged_list_view->refreshData();
+        if (g_pending_page >= 0) {
+            g_paged_file_browser.file_paged_list_view->setCurrentPage(g_pending_page);
         }
-        
-        g_paged_file_browser.all_file_items.push_back(".. (上级目录)");
-        g_paged_file_browser.all_file_full_paths.push_back(std::string(parent_path));
-        g_paged_file_browser.all_is_directory.push_back(true);
+        g_paged_file_browser.file_paged_list_view->markDirty();
     }
-    
-    // 添加所有目录项到列表
-    for (auto& entry : entries) {
-        struct stat st;
-        bool is_dir = (stat(entry.second.c_str(), &st) == 0 && S_ISDIR(st.st_mode));
-        
-        std::string display_name = entry.first;
-        if (is_dir) {
-            display_name = "[DIR] " + display_name;
-        }
-        ESP_LOGD("FileBrowser", "display_name: %s", display_name.c_str());
-        g_paged_file_browser.all_file_items.push_back(display_name);
-        g_paged_file_browser.all_file_full_paths.push_back(entry.second);
-        g_paged_file_browser.all_is_directory.push_back(is_dir);
+    g_pending_page = -1;
+}
+
+/**
+ * @brief 把分批扫描读到的一批目录项追加到列表（在UI任务中调用）
+ * 
+ * 第一批替换掉之前的内容并立即显示第一页，之后的批次只追加，总数和页码随之更新
+ * @param batch 一批目录项，第一批直接作为当前目录项，之后的批次追加到其中
+ * @param first 是否为第一批
+ */
+static void apply_directory_batch(const std::shared_ptr<DirectoryListing>& batch, bool first) {
+    if (batch->path() != g_paged_file_browser.current_path) {
+        return;
+    }
+    if (first || !g_paged_file_browser.entries) {
+        set_directory_entries(batch);
+    } else {
+        g_paged_file_browser.entries->append(*batch, 0, batch->size());
     }
     
-    // 如果分页列表视图已存在，通知它重新加载数据
+    if (g_paged_file_browser.loading_view) {
+        g_paged_file_browser.loading_view->setVisibility(View::GONE);
+    }
     if (g_paged_file_browser.file_paged_list_view) {
+        g_paged_file_browser.file_paged_list_view->setVisibility(View::VISIBLE);
+        if (first) {
+            g_paged_file_browser.file_paged_list_view->setCurrentPage(0);
+        }
         g_paged_file_browser.file_paged_list_view->refreshData();
-        g_paged_file_browser.file_paged_list_view->markDirty();
     }
 }
 
+/**
+ * @brief 分批扫描没有索引的目录，第一页读满就先显示，读完后合并排序并写入索引
+ * @param dir_path 目录路径
+ * @param job 扫描任务
+ * @param first_batch 第一批的项数（一页）
+ * @param load 输出的加载结果
+ */
+static void stream_directory(const std::string& dir_path, const JobHandle& job, size_t first_batch,
+                             directory_load_t& load) {
+    JobScheduler& scheduler = JobScheduler::getInstance();
+    bool first = true;
+    bool ok = DirectoryScanner::scanStreaming(
+        dir_path.c_str(), *load.listing, is_listed_entry, DirectoryScanner::NONE, first_batch,
+        [&](const DirectoryListing& listing, size_t begin, size_t end) {
+            // 扫描线程还会继续修改listing，交给UI任务的是这一批的副本
+            auto batch = std::make_shared<DirectoryListing>();
+            batch->reset(dir_path);
+            batch->append(listing, begin, end);
+            scheduler.post(job, [batch, first]() { apply_directory_batch(batch, first); });
+            first = false;
+        },
+        [&job]() { return job.isCancelled(); });
+    load.streamed = !first;
+    if (ok) {
+        DirectoryIndex::save(*load.listing, INDEX_FILTER_TAG);
+    }
+}
+
+/**
+ * @brief 在后台校验刚显示的目录索引，目录内容变化时增量重建索引并刷新列表
+ * @param load 已显示的加载结果
+ */
+static void verify_directory_index(const directory_load_t& load) {
+    std::shared_ptr<const DirectoryListing> shown = load.listing;
+    bool stale = load.index == DirectoryIndex::STALE;
+    g_verify_job = JobScheduler::getInstance().submitForResult<std::shared_ptr<DirectoryListing>>(
+        [shown, stale](const JobHandle& job) {
+            // 列表正在显示shown，在副本上校验
+            auto listing = std::make_shared<DirectoryListing>(*shown);
+            if (!DirectoryIndex::refresh(listing->path().c_str(), *listing, is_listed_entry, DirectoryScanner::NONE,
+                                         INDEX_FILTER_TAG, stale, [&job]() { return job.isCancelled(); })) {
+                listing.reset();
+            }
+            return listing;
+        },
+        [](std::shared_ptr<DirectoryListing>& listing) {
+            // 目录没有变化，或者已经切换到其他目录
+            if (!listing || listing->path() != g_paged_file_browser.current_path) {
+                return;
+            }
+            // 保持当前页
+            if (g_paged_file_browser.file_paged_list_view) {
+                g_pending_page = g_paged_file_browser.file_paged_list_view->getCurrentPage();
+            }
+            apply_directory_content(std::move(listing));
+        },
+        JobPriority::LOW);
+}
+
+/**
+ * @brief 在后台任务中加载目录内容，完成后在UI任务中显示到列表
+ * 
+ * 优先顺序读取SD卡上的目录索引并立即显示，再在后台校验索引；
+ * 没有索引时分批扫描目录，第一页读满就先显示，读完后按排序结果替换并写入索引。
+ * 之前尚未完成的加载会被取消，SD卡读取不阻塞UI任务
+ * @param path 目录路径
+ */
+static void load_directory_content(const char *path) {
+    g_load_job.cancel();
+    g_verify_job.cancel();
+    std::string dir_path = path;
+    size_t first_batch = PAGE_SIZE;
+    if (g_paged_file_browser.file_paged_list_view) {
+        first_batch = g_paged_file_browser.file_paged_list_view->getRowCount() *
+                      g_paged_file_browser.file_paged_list_view->getColumnCount();
+    }
+    g_load_job = JobScheduler::getInstance().submitForResult<directory_load_t>(
+        [dir_path, first_batch](const JobHandle& job) {
+            directory_load_t load;
+            load.path = dir_path;
+            load.listing = std::make_shared<DirectoryListing>();
+            load.streamed = false;
+            load.index = DirectoryIndex::load(dir_path.c_str(), *load.listing, INDEX_FILTER_TAG);
+            if (load.index == DirectoryIndex::MISSING) {
+                stream_directory(dir_path, job, first_batch, load);
+            }
+            return load;
+        },
+        [](directory_load_t& load) {
+            // 扫描期间已经切换到其他目录时丢弃结果
+            if (load.path != g_paged_file_browser.current_path) {
+                return;
+            }
+            // 分批显示期间用户可能已经翻页，排序完成后停留在同一页
+            if (load.streamed && g_pending_page < 0 && g_paged_file_browser.file_paged_list_view) {
+                g_pending_page = g_paged_file_browser.file_paged_list_view->getCurrentPage();
+            }
+            apply_directory_content(load.listing);
+            if (load.index != DirectoryIndex::MISSING) {
+                verify_directory_index(load);
+            }
+        },
+        JobPriority::HIGH);
+}
+
 /**
  * @brief 更新标题栏显示当前路径
  */
@@ -177,12 +284,21 @@ static void update_title(void) {
  * @brief 文件列表项点击回调
  */
 static void on_file_item_click(int index) {
-    if (index < 0 || index >= (int)g_paged_file_browser.all_file_full_paths.size()) {
+    const std::shared_ptr<DirectoryListing>& entries = g_paged_file_browser.entries;
+    int parent = g_paged_file_browser.has_parent_entry ? 1 : 0;
+    if (!entries || index < 0 || index >= (int)entries->size() + parent) {
         return;
     }
     
-    const std::string& path = g_paged_file_browser.all_file_full_paths[index];
-    bool is_dir = g_paged_file_browser.all_is_directory[index];
+    // 完整路径在点击时才拼接
+    std::string path;
+    bool is_dir = true;
+    if (index < parent) {
+        path = parent_path_of(entries->path());
+    } else {
+        path = entries->fullPathAt(index - parent);
+        is_dir = (*entries)[index - parent].isDirectory;
+    }
     
     if (is_dir) {
         // 是目录，进入该目录
@@ -198,34 +314,62 @@ static void on_file_item_click(int index) {
 }
 
 /**
- * @brief 数据源加载器回调
+ * @brief 文件列表数据源：直接读取当前目录项的名称池
+ * 
+ * 文件名直接指向名称池，目录的显示文字只为当前页拼接
  */
-static std::vector<std::string> data_source_loader(int page, int pageSize) {
-    std::vector<std::string> result;
-    
-    int startIndex = page * pageSize;
-    int endIndex = startIndex + pageSize;
-    
-    if (startIndex < (int)g_paged_file_browser.all_file_items.size()) {
-        endIndex = std::min(endIndex, (int)g_paged_file_browser.all_file_items.size());
-        
-        for (int i = startIndex; i < endIndex; i++) {
-            result.push_back(g_paged_file_browser.all_file_items[i]);
+class FileListAdapter : public ListAdapter {
+public:
+    virtual int count() override {
+        const std::shared_ptr<DirectoryListing>& entries = g_paged_file_browser.entries;
+        if (!entries) {
+            return 0;
         }
+        return entries->size() + (g_paged_file_browser.has_parent_entry ? 1 : 0);
+    }
+
+    virtual int getRange(int offset, int n, ItemList& out) override {
+        out.clear();
+        _labels.clear();
+        int end = std::min(offset + n, count());
+        if (end <= offset) {
+            return 0;
+        }
+        // 预留容量，保证已返回的c_str()不会因为扩容失效
+        _labels.reserve(end - offset);
+        const DirectoryListing& entries = *g_paged_file_browser.entries;
+        int parent = g_paged_file_browser.has_parent_entry ? 1 : 0;
+        for (int i = std::max(offset, 0); i < end; i++) {
+            if (i < parent) {
+                out.push_back(".. (上级目录)");
+                continue;
+            }
+            const char* name = entries.nameAt(i - parent);
+            if (!entries[i - parent].isDirectory) {
+                out.push_back(name);
+                continue;
+            }
+            _labels.emplace_back("[DIR] ");
+            _labels.back() += name;
+            out.push_back(_labels.back().c_str());
+        }
+        return out.size();
     }
-    
-    return result;
-}
+
+private:
+    InternalVector<std::string> _labels;  ///< 当前页目录的显示文字
+};
 
 /**
  * @brief 项目渲染器回调
  */
-static void item_renderer(m5gfx::M5GFX& display, int index, const std::string& item, 
+static void item_renderer(DrawSurface& display, int index, const char* item, 
                          int16_t x, int16_t y, int16_t width, int16_t height) {
     // 确保尺寸有效
     if (width <= 0 || height <= 0) {
         return;
     }
+    TextEllipsizer& ellipsizer = TextEllipsizer::getInstance();
     
     // // 绘制项目背景
     // display.fillRect(x, y, width, height, TFT_WHITE);
@@ -236,39 +380,12 @@ static void item_renderer(m5gfx::M5GFX& display, int index, const std::string& i
     display.setTextSize(1.5);
     
     // 简单的文本绘制，带省略号处理
-    std::string text = item;
-    int16_t text_width = display.textWidth(text.c_str());
     int16_t max_width = width - 10; // 考虑内边距
-    
-    if (text_width > max_width && max_width > 0) {
-        std::string ellipsis = "...";
-        int16_t ellipsis_width = display.textWidth(ellipsis.c_str());
-        
-        int left = 0;
-        int right = text.length();
-        std::string result = ellipsis;
-        
-        while (left <= right && max_width > ellipsis_width) {
-            int mid = left + (right - left) / 2;
-            std::string substr = text.substr(0, mid);
-            std::string candidate = substr + ellipsis;
-            
-            if (display.textWidth(candidate.c_str()) <= max_width) {
-                result = candidate;
-                left = mid + 1;
-            } else {
-                right = mid - 1;
-            }
-        }
-        
-        text = result;
-    }
-    
     int16_t textX = x + 5;
     int16_t textY = y + (height - display.fontHeight()) / 2;
-    ESP_LOGV("FileBrowser", "Rendering item: %s at (%d, %d, %d, %d)", text.c_str(), textX, textY, width, height);
+    ESP_LOGV("FileBrowser", "Rendering item: %s at (%d, %d, %d, %d)", item, textX, textY, width, height);
     display.setCursor(textX, textY);
-    display.print(text.c_str());
+    ellipsizer.print(display, item, max_width);
 }
 
 void paged_file_browser_init(LinearLayout* parent) {
@@ -278,7 +395,7 @@ void paged_file_browser_init(LinearLayout* parent) {
     }
     
     // 初始化当前路径
-    strcpy(g_paged_file_browser.current_path, "/sdcard/books");
+    strcpy(g_paged_file_browser.current_path, SDCARD_BOOKS_DIR);
     
     // 初始化UI组件
     g_paged_file_browser.screen_layout = parent ? parent : nullptr;
@@ -293,6 +410,16 @@ void paged_file_browser_init(LinearLayout* parent) {
         g_paged_file_browser.title_view->setPadding(10, 10, 10, 10); // 设置内边距
         g_paged_file_browser.screen_layout->addChild(g_paged_file_browser.title_view);
         
+        // 创建加载提示，目录扫描完成后替换为文件列表
+        g_paged_file_browser.loading_view = new TextView(
+            g_paged_file_browser.screen_layout->getWidth() - 20, 40);
+        g_paged_file_browser.loading_view->setText("正在加载...");
+        g_paged_file_browser.loading_view->setTextColor(TFT_BLACK);
+        g_paged_file_browser.loading_view->setTextSize(1.5);
+        g_paged_file_browser.loading_view->setTextAlign(1);
+        g_paged_file_browser.loading_view->setPadding(10, 10, 10, 10);
+        g_paged_file_browser.screen_layout->addChild(g_paged_file_browser.loading_view);
+        
         // 创建分页文件列表视图
         int list_height = g_paged_file_browser.screen_layout->getHeight() - 70;
         g_paged_file_browser.file_paged_list_view = new PagedListView(
@@ -302,8 +429,8 @@ void paged_file_browser_init(LinearLayout* parent) {
         g_paged_file_browser.file_paged_list_view->setRowCount(12);
         g_paged_file_browser.file_paged_list_view->setColumnCount(1);
         
-        // 设置数据源加载器
-        g_paged_file_browser.file_paged_list_view->setDataSourceLoader(data_source_loader);
+        // 设置数据源
+        g_paged_file_browser.file_paged_list_view->setAdapter(std::make_shared<FileListAdapter>());
         
         // 设置项目渲染器
         g_paged_file_browser.file_paged_list_view->setItemRenderer(item_renderer);
@@ -312,10 +439,11 @@ void paged_file_browser_init(LinearLayout* parent) {
         g_paged_file_browser.file_paged_list_view->setOnItemClickListener(on_file_item_click);
         
         g_paged_file_browser.file_paged_list_view->setPadding(20, 20, 20, 20); // 设置内边距
+        g_paged_file_browser.file_paged_list_view->setVisibility(View::GONE);
         g_paged_file_browser.screen_layout->addChild(g_paged_file_browser.file_paged_list_view);
     }
     
-    // 加载初始目录内容
+    // 先显示加载提示，目录内容在后台加载
     load_directory_content(g_paged_file_browser.current_path);
     
     // 更新标题
@@ -334,7 +462,7 @@ void paged_file_browser_open_directory(const char * path) {
     // 更新标题
     update_title();
     
-    // 加载目录内容
+    // 在后台加载目录内容，当前列表保留到新内容就绪
     load_directory_content(g_paged_file_browser.current_path);
     
     xSemaphoreGive(paged_file_browser_mutex);
@@ -358,10 +486,18 @@ void register_paged_file_selected_callback(FileSelectedCallback callback) {
 }
 
 void paged_file_browser_deinit(void) {
-    if (paged_file_browser_mutex) {
-        vSemaphoreDelete(paged_file_browser_mutex);
-        paged_file_browser_mutex = NULL;
-    }
+    // 页面已销毁，正在进行的扫描结果不再需要
+    g_load_job.cancel();
+    g_verify_job.cancel();
+    g_pending_page = -1;
+    // 互斥锁不删除：页面销毁后后台扫描可能还没有结束
+    // 视图由页面的根视图释放，这里只清除引用，避免页面被裁剪后访问悬空指针
+    g_paged_file_browser.screen_layout = nullptr;
+    g_paged_file_browser.file_paged_list_view = nullptr;
+    g_paged_file_browser.title_view = nullptr;
+    g_paged_file_browser.loading_view = nullptr;
+    // 释放目录项的名称池
+    set_directory_entries(nullptr);
 }
 
 /**
@@ -393,6 +529,30 @@ bool paged_file_browser_prev_page(void) {
     return false;
 }
 
+/**
+ * @brief 跳转到指定页
+ */
+void paged_file_browser_set_current_page(int page) {
+    if (!g_load_job.isDone()) {
+        // 目录还在加载，加载完成后再跳转
+        g_pending_page = page;
+        return;
+    }
+    if (g_paged_file_browser.file_paged_list_view) {
+        g_paged_file_browser.file_paged_list_view->setCurrentPage(page);
+    }
+}
+
+/**
+ * @brief 获取当前目录项占用的内存（字节）
+ */
+size_t paged_file_browser_get_memory_usage(void) {
+    if (g_paged_file_browser.entries) {
+        return g_paged_file_browser.entries->memoryUsage();
+    }
+    return 0;
+}
+
 /**
  * @brief 获取总页数
  */
@@ -23,12 +23,14 @@ typedef void (*FileSelectedCallback)(const char* filepath);
 
 /**
  * @brief 初始化分页文件浏览器界面
+ * 
+ * 创建视图并显示加载提示，目录内容在后台任务中加载
  * @param parent 父布局对象，如果为NULL则创建新的根布局
  */
 void paged_file_browser_init(LinearLayout* parent);
 
 /**
- * @brief 打开指定目录
+ * @brief 打开指定目录（目录内容在后台任务中加载）
  * @param path 要打开的目录路径
  */
 void paged_file_browser_open_directory(const char * path);
@@ -65,6 +67,12 @@ bool paged_file_browser_next_page(void);
  */
 bool paged_file_browser_prev_page(void);
 
+/**
+ * @brief 跳转到指定页
+ * @param page 页码（从0开始）
+ */
+void paged_file_browser_set_current_page(int page);
+
 /**
  * @brief 获取总页数
  */
@@ -80,6 +88,11 @@ int paged_file_browser_get_current_page(void);
  */
 void set_paged_file_browser_back_callback(void (*callback)(void));
 
+/**
+ * @brief 获取当前目录项占用的内存（字节）
+ */
+size_t paged_file_browser_get_memory_usage(void);
+
 #ifdef __cplusplus
 }
 #endif
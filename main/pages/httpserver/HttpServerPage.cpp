@@ -19,7 +19,31 @@ HttpServerPage::~HttpServerPage() { ESP_LOGD(TAG, "HttpServerPage destroyed"); }
 
 void HttpServerPage::onCreate() {
   Page::onCreate();  
-  if (HttpServer::getInstance().start() != ESP_OK) {
+  _container = new LinearLayout(PageManager::getInstance().getScreenWidth(), PageManager::getInstance().getScreenHeight(), LinearLayout::Orientation::VERTICAL);  
+  _container->setPadding(12, 12, 12, 12);
+  // 先显示启动提示，WiFi热点和HTTP服务在后台启动，不阻塞页面切换
+  _statusView = new TextView(PageManager::getInstance().getScreenWidth() - 24, 50);
+  _statusView->setText("正在启动WiFi热点...");
+  _container->addChild(_statusView);
+  setRootView(_container);
+
+  auto result = std::make_shared<esp_err_t>(ESP_FAIL);
+  _serverState = std::make_shared<std::atomic<ServerState>>(ServerState::STARTING);
+  auto state = _serverState;
+  _startJob = runInBackground([result, state]() {
+                                *result = HttpServer::getInstance().start();
+                                ServerState expected = ServerState::STARTING;
+                                if (!state->compare_exchange_strong(expected, ServerState::RUNNING) &&
+                                    *result == ESP_OK) {
+                                  // 启动期间页面已经销毁，由启动任务自己停止服务器
+                                  HttpServer::getInstance().stop();
+                                }
+                              },
+                              [this, result]() { onServerStarted(*result); });
+}
+
+void HttpServerPage::onServerStarted(esp_err_t result) {
+  if (result != ESP_OK) {
     ESP_LOGE(TAG, "Failed to start HTTP server");
     PageManager::getInstance().finishActivity();
     return;
@@ -27,8 +51,7 @@ void HttpServerPage::onCreate() {
   ESP_LOGI(TAG, "HTTP server started");
   std::string ipAddress = HttpServer::getInstance().getIpAddress();
   ESP_LOGI(TAG, "AP IP Address: %s", ipAddress.c_str());
-  _container = new LinearLayout(M5.Display.width(), M5.Display.height(), LinearLayout::Orientation::VERTICAL);  
-  _container->setPadding(12, 12, 12, 12);
+  _statusView->setVisibility(View::GONE);
   _qrCodeView = new QRCodeView(200, 200);  
   _qrCodeView->setQRCode(HttpServer::getInstance().getApQRCode().c_str());
   _container->addChild(_qrCodeView);
@@ -44,11 +67,14 @@ void HttpServerPage::onCreate() {
   _wifiPassword->setText(wifiPassword);
 //   _container->addChild(_wifiName);
 //   _container->addChild(_wifiPassword);
-  
-  setRootView(_container);
 }
 
 void HttpServerPage::onDestroy() {
-  HttpServer::getInstance().stop();
+  // 启动可能仍在后台进行：尚未开始的直接取消，正在启动的由启动任务结束后自己停止，
+  // 不占用工作线程等待启动完成
+  _startJob.cancel();
+  if (_serverState && _serverState->exchange(ServerState::DESTROYED) == ServerState::RUNNING) {
+    JobScheduler::getInstance().submit([](const JobHandle&) { HttpServer::getInstance().stop(); });
+  }
   Page::onDestroy();
 }
@@ -4,6 +4,10 @@
 #include "../ui_kit/QRCodeView.h"
 #include "../ui_kit/TextView.h"
 #include "LinearLayout.h"
+#include "esp_err.h"
+#include "../jobs/JobScheduler.h"
+#include <atomic>
+#include <memory>
 
 class HttpServerPage : public Page {
 public:
@@ -12,8 +16,19 @@ public:
 
     void onCreate() override;    
     void onDestroy() override;    
+    // 服务器只在页面显示期间运行，离开时直接销毁
+    bool isRetainable() const override { return false; }
 private:
+    // 服务器启动状态，由启动任务和onDestroy共同更新，决定由谁停止服务器
+    enum class ServerState { STARTING, RUNNING, DESTROYED };
+
+    // 后台启动服务器完成后在UI任务中显示二维码
+    void onServerStarted(esp_err_t result);
+
     LinearLayout *_container = nullptr;
+    TextView *_statusView = nullptr;
+    JobHandle _startJob;                                  // 后台启动服务器的任务
+    std::shared_ptr<std::atomic<ServerState>> _serverState;  // 服务器启动状态
     QRCodeView *_qrCodeView = nullptr;
     TextView * _wifiName = nullptr;
     TextView * _wifiPassword = nullptr;
@@ -9,6 +9,8 @@ static const char* TAG = "LauncherPage";
 LauncherPage::LauncherPage() 
     : Page(PageType::MENU, "Launcher"), _layout(nullptr), _settingsButton(nullptr), _fileBrowserButton(nullptr) {
     ESP_LOGI(TAG, "LauncherPage constructed");
+    // 返回该页面的频率很高，保留离屏画布以免每次重绘全部视图
+    setRetainedCanvasEnabled(true);
 }
 
 LauncherPage::~LauncherPage() {
@@ -20,8 +22,8 @@ void LauncherPage::onCreate() {
     ESP_LOGI(TAG, "LauncherPage onCreate");
     
     // 创建主布局
-    auto screenWidth = M5.Display.width();
-    auto screenHeight = M5.Display.height();
+    auto screenWidth = PageManager::getInstance().getScreenWidth();
+    auto screenHeight = PageManager::getInstance().getScreenHeight();
     _layout = new LinearLayout(screenWidth, screenHeight);
     _layout->setOrientation(LinearLayout::Orientation::VERTICAL);    
     _layout->setSpacing(20);  // 设置间距
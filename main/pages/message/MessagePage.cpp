@@ -26,8 +26,8 @@ void MessagePage::onCreate() {
   }
 
   // 获取屏幕尺寸
-  auto screenWidth = M5.Display.width();
-  auto screenHeight = M5.Display.height();
+  auto screenWidth = PageManager::getInstance().getScreenWidth();
+  auto screenHeight = PageManager::getInstance().getScreenHeight();
 
   // 创建主布局
   _layout = new FrameLayout(screenWidth, screenHeight);
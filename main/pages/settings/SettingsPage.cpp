@@ -18,8 +18,8 @@ void SettingsPage::onCreate() {
     ESP_LOGI(TAG, "SettingsPage onCreate");
     
     // 创建主布局
-    auto screenWidth = M5.Display.width();
-    auto screenHeight = M5.Display.height();
+    auto screenWidth = PageManager::getInstance().getScreenWidth();
+    auto screenHeight = PageManager::getInstance().getScreenHeight();
     _layout = new FrameLayout(screenWidth, screenHeight);
     
     // 创建返回按钮
@@ -0,0 +1,75 @@
+#include "IdleRefreshScheduler.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "../render/DisplayPipeline.h"
+#include "../event_loop/UiEventLoop.h"
+
+static const char* TAG = "IdleRefresh";
+
+IdleRefreshScheduler& IdleRefreshScheduler::getInstance() {
+    static IdleRefreshScheduler instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+void IdleRefreshScheduler::init(uint32_t idleDelayMs) {
+    _idleDelayMs = idleDelayMs;
+    _lastInputUs = esp_timer_get_time();
+    ESP_LOGI(TAG, "Ghost cleaning deferred until %u ms without input", (unsigned)_idleDelayMs);
+}
+
+void IdleRefreshScheduler::addDebt(const DirtyRegion& region) {
+    if (region.isEmpty()) {
+        return;
+    }
+    _debt.add(region);
+    armTimer();
+}
+
+void IdleRefreshScheduler::onInput() {
+    _lastInputUs = esp_timer_get_time();
+    if (!_inFlight.isEmpty()) {
+        DisplayPipeline::getInstance().cancelClean();
+    }
+    if (!_debt.isEmpty()) {
+        armTimer();
+    }
+}
+
+void IdleRefreshScheduler::armTimer() {
+    UiEventLoop::getInstance().scheduleTimer(_idleDelayMs, TIMER_ARG);
+}
+
+void IdleRefreshScheduler::poll() {
+    DisplayPipeline& pipeline = DisplayPipeline::getInstance();
+    if (!_inFlight.isEmpty()) {
+        if (pipeline.isRefreshing()) {
+            return;
+        }
+        // 被取消时，没有刷到的区域重新记为债务
+        size_t cleaned = pipeline.cleanedRects();
+        if (cleaned < _inFlight.size()) {
+            for (size_t i = cleaned; i < _inFlight.size(); i++) {
+                _debt.add(_inFlight[i]);
+            }
+            _stats.cancelled++;
+            ESP_LOGD(TAG, "Cleaning interrupted after %u of %u rect(s)", (unsigned)cleaned, (unsigned)_inFlight.size());
+            armTimer();
+        } else {
+            _stats.completed++;
+        }
+        _inFlight.clear();
+    }
+
+    if (_debt.isEmpty() || pipeline.isRefreshing() || pipeline.hasPendingFrame()) {
+        return;
+    }
+    int64_t idleUs = esp_timer_get_time() - _lastInputUs;
+    if (idleUs < static_cast<int64_t>(_idleDelayMs) * 1000) {
+        return;
+    }
+    _inFlight = _debt;
+    _debt.clear();
+    _stats.scheduled++;
+    ESP_LOGD(TAG, "Cleaning %u rect(s) after %lld ms idle", (unsigned)_inFlight.size(), (long long)(idleUs / 1000));
+    pipeline.submitClean(_inFlight);
+}
\ No newline at end of file
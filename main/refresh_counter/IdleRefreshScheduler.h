@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../ui_kit/DirtyRegion.h"
+#include <cstdint>
+
+/**
+ * @brief 空闲清理调度器 - 把清理残影的高质量刷新推迟到无操作的空闲时间
+ * 
+ * 单例模式。刷新策略判定需要清理的区域记为"清理债务"，
+ * 在最后一次输入之后空闲指定时间才交给显示流水线刷新，避免翻页等交互被400ms以上的全刷卡住。
+ * 清理过程中有新的输入时取消尚未开始的区域，未完成的部分重新记为债务。
+ */
+class IdleRefreshScheduler {
+public:
+    static const uint32_t TIMER_ARG = 0x434C4E;  ///< 空闲定时器事件参数（"CLN"）
+
+    /**
+     * @brief 运行统计
+     */
+    struct Stats {
+        uint32_t scheduled = 0;  ///< 开始的清理次数
+        uint32_t completed = 0;  ///< 完成的清理次数
+        uint32_t cancelled = 0;  ///< 被输入打断的清理次数
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return IdleRefreshScheduler单例实例引用
+     */
+    static IdleRefreshScheduler& getInstance();
+
+    /**
+     * @brief 初始化
+     * @param idleDelayMs 最后一次输入之后等待多久开始清理（毫秒）
+     */
+    void init(uint32_t idleDelayMs);
+
+    /**
+     * @brief 记录需要清理的区域
+     * @param region 区域
+     */
+    void addDebt(const DirtyRegion& region);
+
+    /**
+     * @brief 通知有新的输入：重新计时，正在进行的清理尽快停止
+     */
+    void onInput();
+
+    /**
+     * @brief 在UI循环中调用：回收完成的清理，空闲时间足够时开始下一次清理
+     */
+    void poll();
+
+    /**
+     * @brief 是否有尚未清理的区域
+     * @return 有债务或正在清理时返回true
+     */
+    bool hasDebt() const { return !_debt.isEmpty() || !_inFlight.isEmpty(); }
+
+    /**
+     * @brief 获取运行统计
+     * @return 统计信息
+     */
+    Stats getStats() const { return _stats; }
+
+private:
+    IdleRefreshScheduler() = default;
+    ~IdleRefreshScheduler() = default;
+    IdleRefreshScheduler(const IdleRefreshScheduler&) = delete;
+    IdleRefreshScheduler& operator=(const IdleRefreshScheduler&) = delete;
+
+    /**
+     * @brief 安排空闲到期时唤醒UI循环
+     */
+    void armTimer();
+
+    uint32_t _idleDelayMs = 3000;  ///< 空闲等待时间
+    int64_t _lastInputUs = 0;      ///< 最后一次输入的时间
+    DirtyRegion _debt;             ///< 尚未清理的区域
+    DirtyRegion _inFlight;         ///< 正在清理的区域
+    Stats _stats;                  ///< 运行统计
+};
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "RefreshPolicy.h"
+#include <algorithm>
+
+// 灰阶值（0黑 - 15白）低于该值视为深色，高于视为浅色
+static const uint8_t DARK_LEVEL = 3;
+static const uint8_t LIGHT_LEVEL = 12;
+
+RefreshPolicy& RefreshPolicy::getInstance() {
+    static RefreshPolicy instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+void RefreshPolicy::init(const DeviceConfig& config, int16_t width, int16_t height) {
+    _preference = config.refreshMode;
+    uint32_t interval = config.refreshInterval > 0 ? config.refreshInterval : 10;
+    _cleanThreshold = interval * FULL_TILE_COST;
+    _width = width;
+    _height = height;
+    _tilesX = std::min(MAX_TILES, (width + TILE_SIZE - 1) / TILE_SIZE);
+    _tilesY = std::min(MAX_TILES, (height + TILE_SIZE - 1) / TILE_SIZE);
+    reset();
+}
+
+void RefreshPolicy::reset() {
+    for (int y = 0; y < MAX_TILES; y++) {
+        for (int x = 0; x < MAX_TILES; x++) {
+            _ghosting[y][x] = 0;
+        }
+    }
+}
+
+uint32_t RefreshPolicy::ghostingAt(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= _tilesX || tileY >= _tilesY) {
+        return 0;
+    }
+    return _ghosting[tileY][tileX];
+}
+
+Rect RefreshPolicy::tileRect(int tileX, int tileY) const {
+    Rect tile{static_cast<int16_t>(tileX * TILE_SIZE), static_cast<int16_t>(tileY * TILE_SIZE), TILE_SIZE, TILE_SIZE};
+    return tile.intersected(Rect{0, 0, _width, _height});
+}
+
+void RefreshPolicy::analyze(const uint8_t* oldFrame, const uint8_t* newFrame, size_t stride,
+                            const Rect& rect, RegionChangeStats& stats) {
+    stats = RegionChangeStats();
+    stats.rect = rect;
+    if (rect.isEmpty()) {
+        return;
+    }
+    for (int16_t y = rect.y; y < rect.bottom(); y++) {
+        const uint8_t* oldRow = oldFrame + y * stride;
+        const uint8_t* newRow = newFrame + y * stride;
+        for (int16_t x = rect.x; x < rect.right(); x++) {
+            size_t index = x / 2;
+            if (oldRow[index] == newRow[index]) {
+                // 整字节相同，跳过同一字节中的另一个像素
+                if ((x & 1) == 0) {
+                    x++;
+                }
+                continue;
+            }
+            // 每字节两个像素，高半字节在前
+            uint8_t before = (x & 1) ? (oldRow[index] & 0x0F) : (oldRow[index] >> 4);
+            uint8_t after = (x & 1) ? (newRow[index] & 0x0F) : (newRow[index] >> 4);
+            if (before == after) {
+                continue;
+            }
+            stats.changedPixels++;
+            if (after != 0 && after != 0x0F) {
+                stats.grayPixels++;
+            }
+            if (before <= DARK_LEVEL && after >= LIGHT_LEVEL) {
+                stats.blackToWhite++;
+            }
+        }
+    }
+}
+
+uint32_t RefreshPolicy::ghostWeight(Mode mode) {
+    switch (mode) {
+        case Mode::Fastest:
+            return 4;
+        case Mode::Fast:
+            return 3;
+        case Mode::Text:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+RefreshPolicy::Mode RefreshPolicy::chooseMode(uint32_t changed, uint32_t blackToWhite, uint32_t gray) const {
+    uint32_t screenPixels = static_cast<uint32_t>(_width) * _height;
+    bool hasGray = gray * 10 > changed;                      // 超过10%是灰阶内容
+    bool small = changed * 50 < screenPixels;                // 不到2%的屏幕
+    bool mostlyLighten = blackToWhite * 3 > changed;         // 超过1/3由深变浅
+
+    if (_preference == RefreshMode::Quality) {
+        // 黑白内容（包括页面切换）用文本模式显示，残影清理推迟到空闲时
+        if (hasGray) {
+            return Mode::Quality;
+        }
+        return Mode::Text;
+    }
+    if (hasGray) {
+        return Mode::Text;
+    }
+    if (small && !mostlyLighten) {
+        return Mode::Fastest;
+    }
+    return Mode::Fast;
+}
+
+RefreshPolicy::Decision RefreshPolicy::decide(const RegionChangeStats* regions, size_t count) {
+    Decision decision;
+    uint32_t changed = 0;
+    uint32_t blackToWhite = 0;
+    uint32_t gray = 0;
+    for (size_t i = 0; i < count; i++) {
+        changed += regions[i].changedPixels;
+        blackToWhite += regions[i].blackToWhite;
+        gray += regions[i].grayPixels;
+    }
+    if (changed == 0) {
+        decision.mode = Mode::Fastest;
+        return decision;
+    }
+    decision.mode = chooseMode(changed, blackToWhite, gray);
+    uint32_t weight = ghostWeight(decision.mode);
+
+    // 超过半屏的变化（页面切换）直接整块记为需要清理，由空闲时的高质量刷新偿还
+    uint32_t screenPixels = static_cast<uint32_t>(_width) * _height;
+    bool navigation = weight > 0 && changed * 2 > screenPixels;
+
+    // 按覆盖面积把变化分摊到瓦片上：高质量刷新清除残影，其他模式累计残影
+    for (size_t i = 0; i < count; i++) {
+        const RegionChangeStats& region = regions[i];
+        int32_t regionArea = region.rect.area();
+        if (regionArea <= 0 || region.changedPixels == 0) {
+            continue;
+        }
+        int firstX = std::max(0, region.rect.x / TILE_SIZE);
+        int lastX = std::min(_tilesX - 1, (region.rect.right() - 1) / TILE_SIZE);
+        int firstY = std::max(0, region.rect.y / TILE_SIZE);
+        int lastY = std::min(_tilesY - 1, (region.rect.bottom() - 1) / TILE_SIZE);
+        for (int ty = firstY; ty <= lastY; ty++) {
+            for (int tx = firstX; tx <= lastX; tx++) {
+                Rect tile = tileRect(tx, ty);
+                int32_t overlap = tile.intersected(region.rect).area();
+                if (overlap <= 0) {
+                    continue;
+                }
+                uint32_t& ghost = _ghosting[ty][tx];
+                if (weight == 0) {
+                    // 覆盖了整块瓦片时完全清除，部分覆盖时按比例减少
+                    ghost = ghost - static_cast<uint32_t>(static_cast<uint64_t>(ghost) * overlap / tile.area());
+                    continue;
+                }
+                if (navigation) {
+                    decision.cleanRegion.add(tile);
+                    ghost = 0;
+                    continue;
+                }
+                // 瓦片内的变化按区域面积比例估算，由深变浅的像素计两次
+                uint64_t pixels = static_cast<uint64_t>(region.changedPixels + region.blackToWhite) * overlap / regionArea;
+                ghost += static_cast<uint32_t>(pixels * weight * (FULL_TILE_COST / 3) / tile.area());
+                if (ghost >= _cleanThreshold) {
+                    decision.cleanRegion.add(tile);
+                    ghost = 0;
+                }
+            }
+        }
+    }
+    return decision;
+}
\ No newline at end of file
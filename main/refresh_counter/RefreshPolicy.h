@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../ui_kit/Rect.h"
+#include "../ui_kit/DirtyRegion.h"
+#include "../config/DeviceConfig.h"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief 一次更新中某个区域的像素变化统计
+ */
+struct RegionChangeStats {
+    Rect rect;                   ///< 区域
+    uint32_t changedPixels = 0;  ///< 变化的像素数
+    uint32_t blackToWhite = 0;   ///< 由深变浅的像素数（最容易留下残影）
+    uint32_t grayPixels = 0;     ///< 新内容中的灰阶像素数（非纯黑白）
+};
+
+/**
+ * @brief 自适应刷新策略 - 为每次更新选择墨水屏刷新模式
+ * 
+ * 单例模式，替代原来每N次全刷一次的固定计数。
+ * 根据变化区域的面积、由深变浅的像素比例以及是否包含灰阶，
+ * 在Fastest/Fast/Text/Quality之间选择（由DisplayPipeline映射到屏幕的刷新模式），
+ * 并按屏幕瓦片累计残影，只在残影超过阈值的瓦片上做清理刷新。
+ * 策略本身只做计算，不依赖屏幕驱动和日志，可以在主机上用合成的帧序列单独验证。
+ */
+class RefreshPolicy {
+public:
+    static constexpr int16_t TILE_SIZE = 60;      ///< 残影统计瓦片边长（像素）
+    static constexpr int MAX_TILES = 16;          ///< 每个方向最多的瓦片数
+    static constexpr uint32_t FULL_TILE_COST = 300; ///< 整块瓦片用快刷更新一次累计的残影
+
+    /**
+     * @brief 墨水屏刷新模式（残影由少到多）
+     */
+    enum class Mode : uint8_t {
+        Quality,  ///< 高质量，支持灰阶并清除残影（对应epd_quality）
+        Text,     ///< 黑白文本（对应epd_text）
+        Fast,     ///< 快速（对应epd_fast）
+        Fastest,  ///< 最快（对应epd_fastest）
+    };
+
+    /**
+     * @brief 刷新决策
+     */
+    struct Decision {
+        Mode mode = Mode::Fast;   ///< 本次更新使用的刷新模式
+        DirtyRegion cleanRegion;  ///< 残影超过阈值、需要用高质量模式清理的区域
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return RefreshPolicy单例实例引用
+     */
+    static RefreshPolicy& getInstance();
+
+    /**
+     * @brief 根据设备配置和屏幕尺寸初始化
+     * @param config 设备配置（refreshMode决定偏好，refreshInterval决定清理阈值）
+     * @param width 屏幕宽度
+     * @param height 屏幕高度
+     */
+    void init(const DeviceConfig& config, int16_t width, int16_t height);
+
+    /**
+     * @brief 统计两帧4bpp缓冲区在指定区域内的像素变化
+     * @param oldFrame 旧帧
+     * @param newFrame 新帧
+     * @param stride 行跨度（字节）
+     * @param rect 区域
+     * @param stats 输出的统计信息
+     */
+    static void analyze(const uint8_t* oldFrame, const uint8_t* newFrame, size_t stride,
+                        const Rect& rect, RegionChangeStats& stats);
+
+    /**
+     * @brief 为一次更新选择刷新模式，并累计残影
+     * @param regions 各区域的变化统计
+     * @param count 区域数量
+     * @return 刷新决策
+     */
+    Decision decide(const RegionChangeStats* regions, size_t count);
+
+    /**
+     * @brief 整屏已用高质量模式刷新，清空残影
+     */
+    void reset();
+
+    /**
+     * @brief 获取瓦片累计的残影
+     * @param tileX 瓦片列
+     * @param tileY 瓦片行
+     * @return 残影值，越界返回0
+     */
+    uint32_t ghostingAt(int tileX, int tileY) const;
+
+    /**
+     * @brief 获取清理阈值
+     * @return 瓦片残影超过该值时需要清理
+     */
+    uint32_t getCleanThreshold() const { return _cleanThreshold; }
+
+private:
+    RefreshPolicy() = default;
+    ~RefreshPolicy() = default;
+    RefreshPolicy(const RefreshPolicy&) = delete;
+    RefreshPolicy& operator=(const RefreshPolicy&) = delete;
+
+    /**
+     * @brief 根据统计信息选择刷新模式
+     */
+    Mode chooseMode(uint32_t changed, uint32_t blackToWhite, uint32_t gray) const;
+
+    /**
+     * @brief 某种刷新模式每个变化像素累计的残影权重
+     */
+    static uint32_t ghostWeight(Mode mode);
+
+    /**
+     * @brief 获取瓦片的屏幕区域
+     */
+    Rect tileRect(int tileX, int tileY) const;
+
+    RefreshMode _preference = RefreshMode::Quality;  ///< 用户偏好
+    uint32_t _cleanThreshold = 10 * FULL_TILE_COST;  ///< 清理阈值
+    int16_t _width = 0;                              ///< 屏幕宽度
+    int16_t _height = 0;                             ///< 屏幕高度
+    int _tilesX = 0;                                 ///< 瓦片列数
+    int _tilesY = 0;                                 ///< 瓦片行数
+    uint32_t _ghosting[MAX_TILES][MAX_TILES] = {};   ///< 每个瓦片累计的残影
+};
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "DisplayPipeline.h"
+#include "M5Unified.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include <utility>
+#include "../refresh_counter/RefreshPolicy.h"
+#include "../refresh_counter/IdleRefreshScheduler.h"
+#include "../event_loop/UiEventLoop.h"
+
+static const char* TAG = "DisplayPipeline";
+
+/**
+ * @brief 把刷新策略的决策转换为屏幕的刷新模式，残影清理区域交给空闲刷新调度
+ * @param decision 刷新决策
+ * @return 屏幕刷新模式
+ */
+static m5gfx::epd_mode_t applyDecision(const RefreshPolicy::Decision& decision) {
+    // 残影清理推迟到空闲时间，不阻塞这次交互
+    IdleRefreshScheduler::getInstance().addDebt(decision.cleanRegion);
+    ESP_LOGD(TAG, "Refresh mode %d, clean %u rect(s)", static_cast<int>(decision.mode),
+             (unsigned)decision.cleanRegion.size());
+    switch (decision.mode) {
+        case RefreshPolicy::Mode::Quality:
+            return m5gfx::epd_mode_t::epd_quality;
+        case RefreshPolicy::Mode::Text:
+            return m5gfx::epd_mode_t::epd_text;
+        case RefreshPolicy::Mode::Fastest:
+            return m5gfx::epd_mode_t::epd_fastest;
+        default:
+            return m5gfx::epd_mode_t::epd_fast;
+    }
+}
+
+DisplayPipeline& DisplayPipeline::getInstance() {
+    static DisplayPipeline instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+bool DisplayPipeline::init() {
+    int16_t width = M5.Display.width();
+    int16_t height = M5.Display.height();
+    const lgfx::IFont* font = M5.Display.getFont();
+    if (!_buffers[0].create(width, height, true, font) || !_buffers[1].create(width, height, true, font)) {
+        ESP_LOGW(TAG, "Failed to allocate display buffers, drawing directly to the panel");
+        _buffers[0].release();
+        _buffers[1].release();
+        return false;
+    }
+    _back = &_buffers[0];
+    _front = &_buffers[1];
+
+    QueueHandle_t queue = xQueueCreate(1, sizeof(Frame));
+    if (queue == nullptr) {
+        ESP_LOGE(TAG, "Failed to create frame queue");
+        _buffers[0].release();
+        _buffers[1].release();
+        return false;
+    }
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "epd_pipeline", &_refreshLock) != ESP_OK) {
+        _refreshLock = nullptr;
+    }
+    if (xTaskCreatePinnedToCore(&DisplayPipeline::displayTask, "display_task", DISPLAY_TASK_STACK, this,
+                                DISPLAY_TASK_PRIORITY, nullptr, DISPLAY_TASK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create display task");
+        vQueueDelete(queue);
+        _buffers[0].release();
+        _buffers[1].release();
+        return false;
+    }
+    _frameQueue = queue;
+    ESP_LOGI(TAG, "Double buffered display %dx%d", width, height);
+    return true;
+}
+
+DrawSurface& DisplayPipeline::drawTarget() {
+    if (isBuffered()) {
+        return *_back;
+    }
+    return M5.Display;
+}
+
+void DisplayPipeline::submit(const DirtyRegion& region, bool fullRefresh) {
+    if (!fullRefresh && region.isEmpty()) {
+        return;
+    }
+
+    if (isBuffered()) {
+        // 与尚未显示的帧合并，只刷新最终状态
+        _pendingFull = _pendingFull || fullRefresh;
+        _pendingRegion.add(region);
+        return;
+    }
+
+    // 没有双缓冲：在UI任务中直接刷新。没有上一帧可比较，按区域面积估算变化
+    Frame frame;
+    frame.source = nullptr;
+    frame.fullRefresh = fullRefresh;
+    frame.cleanOnly = false;
+    RegionChangeStats stats[DirtyRegion::MAX_RECTS];
+    size_t count = 0;
+    if (fullRefresh) {
+        frame.region.add(Rect{0, 0, static_cast<int16_t>(M5.Display.width()), static_cast<int16_t>(M5.Display.height())});
+    } else {
+        frame.region = region;
+    }
+    for (const Rect& rect : frame.region) {
+        stats[count].rect = rect;
+        stats[count].changedPixels = rect.area();
+        count++;
+    }
+    frame.epdMode = applyDecision(RefreshPolicy::getInstance().decide(stats, count));
+    pushToPanel(frame);
+    UiEventLoop::getInstance().onDisplayPushed();
+}
+
+void DisplayPipeline::present() {
+    if (!isBuffered() || !hasPendingFrame() || _refreshing.load()) {
+        return;
+    }
+
+    Frame frame;
+    frame.region = _pendingRegion;
+    frame.fullRefresh = _pendingFull;
+    frame.cleanOnly = false;
+    _pendingRegion.clear();
+    _pendingFull = false;
+
+    // 交换缓冲：交换后_back保存着上一帧，在补上这一帧的变化之前先和新帧比较
+    std::swap(_back, _front);
+    decideRefresh(frame);
+
+    // 新的后台缓冲需要补上这一帧的变化，保持与最新一帧一致
+    if (frame.fullRefresh) {
+        _back->copyRectFrom(*_front, Rect{0, 0, static_cast<int16_t>(_front->width()), static_cast<int16_t>(_front->height())});
+    } else {
+        for (const Rect& rect : frame.region) {
+            _back->copyRectFrom(*_front, rect);
+        }
+    }
+
+    frame.source = _front;
+    if (_refreshLock != nullptr) {
+        esp_pm_lock_acquire(_refreshLock);
+    }
+    _refreshing = true;
+    xQueueSend(_frameQueue, &frame, portMAX_DELAY);
+}
+
+void DisplayPipeline::decideRefresh(Frame& frame) const {
+    const uint8_t* previous = static_cast<const uint8_t*>(_back->getBuffer());
+    const uint8_t* next = static_cast<const uint8_t*>(_front->getBuffer());
+    size_t stride = _front->stride();
+    RegionChangeStats stats[DirtyRegion::MAX_RECTS];
+    size_t count = 0;
+    if (frame.fullRefresh) {
+        Rect screen{0, 0, static_cast<int16_t>(_front->width()), static_cast<int16_t>(_front->height())};
+        RefreshPolicy::analyze(previous, next, stride, screen, stats[count++]);
+    } else {
+        for (const Rect& rect : frame.region) {
+            RefreshPolicy::analyze(previous, next, stride, rect, stats[count++]);
+        }
+    }
+    frame.epdMode = applyDecision(RefreshPolicy::getInstance().decide(stats, count));
+}
+
+void DisplayPipeline::pushToPanel(const Frame& frame) {
+    // 直接绘制模式下内容已经在屏幕缓冲中
+    if (frame.source != nullptr) {
+        FrameBufferSurface& source = *frame.source;
+        M5.Display.startWrite();
+        if (frame.fullRefresh) {
+            source.pushSprite(&M5.Display, 0, 0);
+        } else {
+            for (const Rect& rect : frame.region) {
+                M5.Display.setClipRect(rect.x, rect.y, rect.w, rect.h);
+                source.pushSprite(&M5.Display, 0, 0);
+            }
+            M5.Display.clearClipRect();
+        }
+        M5.Display.endWrite();
+    }
+
+    M5.Display.setEpdMode(frame.epdMode);
+    if (frame.fullRefresh) {
+        M5.Display.display();
+    } else {
+        for (const Rect& rect : frame.region) {
+            ESP_LOGD(TAG, "局部刷新: x=%d, y=%d, w=%d, h=%d", rect.x, rect.y, rect.w, rect.h);
+            M5.Display.display(rect.x, rect.y, rect.w, rect.h);
+        }
+    }
+    M5.Display.waitDisplay();
+}
+
+bool DisplayPipeline::submitClean(const DirtyRegion& region) {
+    if (region.isEmpty() || _refreshing.load()) {
+        return false;
+    }
+    Frame frame;
+    frame.source = nullptr;
+    frame.region = region;
+    frame.fullRefresh = false;
+    frame.cleanOnly = true;
+    frame.epdMode = m5gfx::epd_mode_t::epd_quality;
+    _cleanCancelled = false;
+    _cleanedRects = 0;
+
+    if (!isBuffered()) {
+        cleanPanel(frame);
+        UiEventLoop::getInstance().onDisplayPushed();
+        return true;
+    }
+    if (_refreshLock != nullptr) {
+        esp_pm_lock_acquire(_refreshLock);
+    }
+    _refreshing = true;
+    xQueueSend(_frameQueue, &frame, portMAX_DELAY);
+    return true;
+}
+
+void DisplayPipeline::cleanPanel(const Frame& frame) {
+    // 面板的刷新无法中途打断，只能在区域之间检查取消
+    M5.Display.setEpdMode(frame.epdMode);
+    for (const Rect& rect : frame.region) {
+        if (_cleanCancelled.load()) {
+            break;
+        }
+        ESP_LOGD(TAG, "清理残影: x=%d, y=%d, w=%d, h=%d", rect.x, rect.y, rect.w, rect.h);
+        M5.Display.display(rect.x, rect.y, rect.w, rect.h);
+        M5.Display.waitDisplay();
+        _cleanedRects++;
+    }
+}
+
+void DisplayPipeline::displayTask(void* param) {
+    DisplayPipeline* self = static_cast<DisplayPipeline*>(param);
+    Frame frame;
+    while (true) {
+        if (xQueueReceive(self->_frameQueue, &frame, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        int64_t start = esp_timer_get_time();
+        if (frame.cleanOnly) {
+            self->cleanPanel(frame);
+        } else {
+            pushToPanel(frame);
+        }
+        ESP_LOGD(TAG, "Refresh finished in %lld ms", (long long)((esp_timer_get_time() - start) / 1000));
+
+        self->_refreshing = false;
+        if (self->_refreshLock != nullptr) {
+            esp_pm_lock_release(self->_refreshLock);
+        }
+        // 唤醒UI任务显示刷新期间准备好的帧
+        UiEventLoop::getInstance().post(UiEventLoop::EventType::DISPLAY_DONE);
+    }
+}
\ No newline at end of file
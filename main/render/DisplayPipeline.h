@@ -0,0 +1,138 @@
+#pragma once
+
+#include "FrameBufferSurface.h"
+#include "../ui_kit/DirtyRegion.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_pm.h"
+#include <atomic>
+
+/**
+ * @brief 显示流水线 - 把墨水屏刷新从UI任务中分离出来
+ * 
+ * 单例模式。UI任务绘制到后台缓冲并提交变化区域；面板空闲时交换前后台缓冲，
+ * 由另一个核心上的显示任务把前台缓冲推送到屏幕并等待刷新完成。
+ * 刷新期间UI任务可以继续处理触摸并准备下一帧，多次提交会合并为一次刷新。
+ * 缓冲区申请失败时退回在UI任务中直接绘制和刷新。
+ */
+class DisplayPipeline {
+public:
+    static const BaseType_t DISPLAY_TASK_CORE = 0;        ///< 显示任务所在核心（UI任务在核心1）
+    static const uint32_t DISPLAY_TASK_STACK = 4096;      ///< 显示任务栈大小
+    static const UBaseType_t DISPLAY_TASK_PRIORITY = 2;   ///< 显示任务优先级
+
+    /**
+     * @brief 获取单例实例
+     * @return DisplayPipeline单例实例引用
+     */
+    static DisplayPipeline& getInstance();
+
+    /**
+     * @brief 初始化双缓冲和显示任务（需要在M5.begin和设置字体之后调用）
+     * @return 双缓冲可用返回true，否则退回直接绘制并返回false
+     */
+    bool init();
+
+    /**
+     * @brief 检查双缓冲是否可用
+     * @return 可用返回true，否则返回false
+     */
+    bool isBuffered() const { return _frameQueue != nullptr; }
+
+    /**
+     * @brief 获取UI任务绘制的目标
+     * @return 双缓冲可用时返回后台缓冲，否则返回屏幕
+     */
+    DrawSurface& drawTarget();
+
+    /**
+     * @brief 提交一帧的变化区域
+     * 
+     * 双缓冲模式下只记录区域，在present时才交给显示任务；未处理的提交会合并。
+     * @param region 变化区域
+     * @param fullRefresh 是否需要整屏刷新
+     */
+    void submit(const DirtyRegion& region, bool fullRefresh);
+
+    /**
+     * @brief 面板空闲且有待显示的帧时交换缓冲并交给显示任务
+     */
+    void present();
+
+    /**
+     * @brief 用高质量模式重刷指定区域以清理残影（面板空闲时调用）
+     * 
+     * 按区域逐个刷新，调用cancelClean后不再开始剩余的区域。
+     * @param region 需要清理的区域
+     * @return 已开始清理返回true，面板正忙返回false
+     */
+    bool submitClean(const DirtyRegion& region);
+
+    /**
+     * @brief 停止正在进行的清理（已经开始的区域会刷完）
+     */
+    void cancelClean() { _cleanCancelled = true; }
+
+    /**
+     * @brief 获取最近一次清理完成的区域数
+     * @return 区域数
+     */
+    size_t cleanedRects() const { return _cleanedRects.load(); }
+
+    /**
+     * @brief 是否有已提交但尚未交给显示任务的帧
+     * @return 有待显示的帧返回true
+     */
+    bool hasPendingFrame() const { return _pendingFull || !_pendingRegion.isEmpty(); }
+
+    /**
+     * @brief 显示任务是否正在刷新面板
+     * @return 正在刷新返回true
+     */
+    bool isRefreshing() const { return _refreshing.load(); }
+
+private:
+    /**
+     * @brief 交给显示任务的一帧
+     */
+    struct Frame {
+        FrameBufferSurface* source;  ///< 需要推送的缓冲区
+        DirtyRegion region;          ///< 需要推送的区域
+        bool fullRefresh;            ///< 是否整屏刷新
+        m5gfx::epd_mode_t epdMode;   ///< 刷新模式
+        bool cleanOnly;              ///< 只用高质量模式重刷区域以清理残影，不推送新内容
+    };
+
+    DisplayPipeline() = default;
+    ~DisplayPipeline() = default;
+    DisplayPipeline(const DisplayPipeline&) = delete;
+    DisplayPipeline& operator=(const DisplayPipeline&) = delete;
+
+    static void displayTask(void* param);
+
+    /**
+     * @brief 把缓冲区的内容推送到屏幕并刷新
+     */
+    static void pushToPanel(const Frame& frame);
+
+    /**
+     * @brief 逐个区域用高质量模式重刷，收到取消时停止
+     */
+    void cleanPanel(const Frame& frame);
+
+    /**
+     * @brief 统计待显示区域相对上一帧的变化并交给刷新策略决定刷新模式
+     */
+    void decideRefresh(Frame& frame) const;
+
+    FrameBufferSurface _buffers[2];              ///< 双缓冲
+    FrameBufferSurface* _back = nullptr;         ///< 后台缓冲（UI任务绘制）
+    FrameBufferSurface* _front = nullptr;        ///< 前台缓冲（显示任务推送）
+    QueueHandle_t _frameQueue = nullptr;         ///< 交给显示任务的帧队列
+    esp_pm_lock_handle_t _refreshLock = nullptr; ///< 刷新期间禁止浅睡眠
+    std::atomic<bool> _refreshing{false};        ///< 显示任务是否正在刷新
+    std::atomic<bool> _cleanCancelled{false};    ///< 清理是否被取消
+    std::atomic<size_t> _cleanedRects{0};        ///< 最近一次清理完成的区域数
+    DirtyRegion _pendingRegion;                  ///< 已提交未显示的区域
+    bool _pendingFull = false;                   ///< 已提交未显示的帧是否需要整屏刷新
+};
\ No newline at end of file
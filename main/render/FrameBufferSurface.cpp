@@ -0,0 +1,117 @@
+#include "FrameBufferSurface.h"
+#include "esp_log.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+static const char* TAG = "FrameBufferSurface";
+
+FrameBufferSurface::FrameBufferSurface() {
+}
+
+FrameBufferSurface::~FrameBufferSurface() {
+    release();
+}
+
+bool FrameBufferSurface::create(int16_t width, int16_t height, bool usePsram, const lgfx::IFont* font) {
+    release();
+    setPsram(usePsram);
+    setColorDepth(lgfx::color_depth_t::grayscale_4bit);
+    if (createSprite(width, height) == nullptr) {
+        ESP_LOGW(TAG, "Failed to allocate %dx%d frame buffer%s", width, height, usePsram ? " in PSRAM" : "");
+        return false;
+    }
+    if (font != nullptr) {
+        setFont(font);
+    }
+    fillScreen(TFT_WHITE);
+    ESP_LOGD(TAG, "Frame buffer %dx%d (%u bytes)", width, height, (unsigned)bufferLength());
+    return true;
+}
+
+void FrameBufferSurface::release() {
+    if (isCreated()) {
+        deleteSprite();
+    }
+}
+
+size_t FrameBufferSurface::stride() const {
+    return height() > 0 ? bufferLength() / height() : 0;
+}
+
+uint8_t FrameBufferSurface::grayAt(int16_t x, int16_t y) const {
+    const uint8_t* data = static_cast<const uint8_t*>(getBuffer());
+    if (data == nullptr || x < 0 || y < 0 || x >= width() || y >= height()) {
+        return 0;
+    }
+    // 每字节两个像素，高半字节在前
+    uint8_t value = data[y * stride() + x / 2];
+    return (x & 1) ? (value & 0x0F) : (value >> 4);
+}
+
+void FrameBufferSurface::copyRectFrom(const FrameBufferSurface& source, const Rect& rect) {
+    uint8_t* dst = static_cast<uint8_t*>(getBuffer());
+    const uint8_t* src = static_cast<const uint8_t*>(source.getBuffer());
+    if (dst == nullptr || src == nullptr || source.bufferLength() != bufferLength()) {
+        return;
+    }
+    Rect clipped = rect.intersected(Rect{0, 0, static_cast<int16_t>(width()), static_cast<int16_t>(height())});
+    if (clipped.isEmpty()) {
+        return;
+    }
+    size_t rowStride = stride();
+    size_t byteBegin = clipped.x / 2;
+    size_t byteEnd = std::min(rowStride, static_cast<size_t>(clipped.right() + 1) / 2);
+    for (int16_t y = clipped.y; y < clipped.bottom(); y++) {
+        size_t offset = y * rowStride + byteBegin;
+        memcpy(dst + offset, src + offset, byteEnd - byteBegin);
+    }
+}
+
+uint32_t FrameBufferSurface::checksum() const {
+    const uint8_t* data = static_cast<const uint8_t*>(getBuffer());
+    uint32_t hash = 2166136261u;
+    if (data == nullptr) {
+        return hash;
+    }
+    size_t length = bufferLength();
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool FrameBufferSurface::savePgm(const char* path) const {
+    if (!isCreated()) {
+        return false;
+    }
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return false;
+    }
+
+    int16_t w = width();
+    int16_t h = height();
+    fprintf(file, "P5\n%d %d\n255\n", w, h);
+
+    uint8_t row[64];
+    bool ok = true;
+    for (int16_t y = 0; y < h && ok; y++) {
+        // 分块展开为8位灰度写出，避免整行缓冲
+        for (int16_t x = 0; x < w && ok; x += sizeof(row)) {
+            size_t count = std::min(static_cast<size_t>(w - x), sizeof(row));
+            for (size_t i = 0; i < count; i++) {
+                row[i] = grayAt(x + i, y) * 17;
+            }
+            ok = fwrite(row, 1, count, file) == count;
+        }
+    }
+    fclose(file);
+
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to write %s", path);
+    }
+    return ok;
+}
\ No newline at end of file
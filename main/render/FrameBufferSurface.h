@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../ui_kit/DrawSurface.h"
+#include "../ui_kit/Rect.h"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief 内存帧缓冲绘制表面（4bpp灰度）
+ * 
+ * 基于M5Canvas，不依赖屏幕硬件：页面的离屏画布使用它，
+ * 也可以把视图树直接绘制到这里，用于测量布局/绘制耗时以及与基准图像比对。
+ */
+class FrameBufferSurface : public M5Canvas {
+public:
+    /**
+     * @brief 构造函数（不分配缓冲区）
+     */
+    FrameBufferSurface();
+
+    /**
+     * @brief 析构函数
+     */
+    ~FrameBufferSurface();
+
+    /**
+     * @brief 分配帧缓冲并填充为白色
+     * @param width 宽度
+     * @param height 高度
+     * @param usePsram 是否分配在PSRAM中
+     * @param font 默认字体（为空时使用LovyanGFX默认字体）
+     * @return 分配成功返回true，否则返回false
+     */
+    bool create(int16_t width, int16_t height, bool usePsram = true, const lgfx::IFont* font = nullptr);
+
+    /**
+     * @brief 释放帧缓冲
+     */
+    void release();
+
+    /**
+     * @brief 检查帧缓冲是否已分配
+     * @return 已分配返回true，否则返回false
+     */
+    bool isCreated() const { return getBuffer() != nullptr; }
+
+    /**
+     * @brief 获取行跨度
+     * @return 每行字节数
+     */
+    size_t stride() const;
+
+    /**
+     * @brief 读取像素灰度
+     * @param x X坐标
+     * @param y Y坐标
+     * @return 灰度值（0黑 - 15白），越界返回0
+     */
+    uint8_t grayAt(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 从另一个同尺寸的帧缓冲复制一块区域（左右边界按整字节处理）
+     * @param source 源帧缓冲
+     * @param rect 区域
+     */
+    void copyRectFrom(const FrameBufferSurface& source, const Rect& rect);
+
+    /**
+     * @brief 计算帧内容的校验和（FNV-1a），用于快速比对基准图像
+     * @return 校验和
+     */
+    uint32_t checksum() const;
+
+    /**
+     * @brief 保存为8位灰度PGM图像
+     * @param path 文件路径
+     * @return 保存成功返回true，否则返回false
+     */
+    bool savePgm(const char* path) const;
+
+private:
+    FrameBufferSurface(const FrameBufferSurface&) = delete;
+    FrameBufferSurface& operator=(const FrameBufferSurface&) = delete;
+};
\ No newline at end of file
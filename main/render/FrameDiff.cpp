@@ -0,0 +1,70 @@
+#include "FrameDiff.h"
+#include "M5GFX.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <cstring>
+
+static const char* TAG = "FrameDiff";
+
+FrameDiff& FrameDiff::getInstance() {
+    static FrameDiff instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+FrameDiff::~FrameDiff() {
+    if (_shadow != nullptr) {
+        heap_caps_free(_shadow);
+        _shadow = nullptr;
+    }
+}
+
+bool FrameDiff::ensureShadow(M5Canvas& canvas) {
+    int16_t width = canvas.width();
+    int16_t height = canvas.height();
+    size_t length = canvas.bufferLength();
+    if (_shadow != nullptr && width == _width && height == _height && length == _shadowLength) {
+        return true;
+    }
+
+    if (_shadow != nullptr) {
+        heap_caps_free(_shadow);
+        _shadow = nullptr;
+    }
+    _valid = false;
+    if (height <= 0 || length == 0) {
+        return false;
+    }
+    _shadow = static_cast<uint8_t*>(heap_caps_malloc(length, MALLOC_CAP_SPIRAM | MALLOC_CAP_32BIT));
+    if (_shadow == nullptr) {
+        ESP_LOGW(TAG, "Failed to allocate %u bytes for the shadow frame", (unsigned)length);
+        return false;
+    }
+    _shadowLength = length;
+    _stride = length / height;
+    _width = width;
+    _height = height;
+    ESP_LOGI(TAG, "Shadow frame %dx%d, stride %u", _width, _height, (unsigned)_stride);
+    return true;
+}
+
+bool FrameDiff::diff(M5Canvas& canvas, const Rect& area, DirtyRegion& changed) {
+    const uint8_t* next = static_cast<const uint8_t*>(canvas.getBuffer());
+    Rect clipped = area.intersected(Rect{0, 0, static_cast<int16_t>(canvas.width()), static_cast<int16_t>(canvas.height())});
+    if (clipped.isEmpty()) {
+        return false;
+    }
+    if (next == nullptr || !ensureShadow(canvas)) {
+        // 无法比较时保守地认为整个区域都变化了
+        changed.add(clipped);
+        return true;
+    }
+
+    if (!_valid) {
+        // 屏幕内容未知：整帧同步到影子帧，并整帧推送
+        memcpy(_shadow, next, _shadowLength);
+        _valid = true;
+        changed.add(Rect{0, 0, _width, _height});
+        return true;
+    }
+    return diffBuffers(_shadow, next, _stride, clipped, changed);
+}
\ No newline at end of file
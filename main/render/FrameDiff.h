@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../ui_kit/Rect.h"
+#include "../ui_kit/DirtyRegion.h"
+#include <cstdint>
+#include <cstddef>
+
+// 前向声明
+class M5Canvas;
+
+/**
+ * @brief 帧差分引擎 - 计算真正需要推送到墨水屏的最小区域
+ * 
+ * 单例模式，在PSRAM中保存上一次推送到屏幕的4bpp帧。
+ * 推送前逐行按32位字异或比较新旧帧，输出实际变化像素的紧凑包围盒，
+ * 视图重绘出相同像素（标题、列表边框等）时不再产生任何刷新。
+ */
+class FrameDiff {
+public:
+    static const int16_t MERGE_GAP_ROWS = 8;  ///< 相隔不超过该行数的变化行合并为同一个包围盒
+
+    /**
+     * @brief 获取单例实例
+     * @return FrameDiff单例实例引用
+     */
+    static FrameDiff& getInstance();
+
+    /**
+     * @brief 对比画布指定区域与上一次推送的帧，并把该区域记为已推送
+     * 
+     * 上一帧未知（首次使用、画布尺寸变化或调用过invalidate）时整帧都视为变化。
+     * 区域的左右边界会扩展到整字节，输出的包围盒可能略大于传入区域。
+     * @param canvas 4bpp画布（新帧）
+     * @param area 需要比较的区域
+     * @param changed 输出的变化区域
+     * @return 有像素变化返回true，否则返回false
+     */
+    bool diff(M5Canvas& canvas, const Rect& area, DirtyRegion& changed);
+
+    /**
+     * @brief 屏幕内容不再与记录的帧一致（例如直接绘制到了屏幕上）
+     */
+    void invalidate() { _valid = false; }
+
+    /**
+     * @brief 对比两块4bpp缓冲区的指定区域
+     * 
+     * 两块缓冲区的尺寸和行跨度必须相同，比较后把变化的字节同步到prev。
+     * @param prev 旧帧
+     * @param next 新帧
+     * @param stride 行跨度（字节）
+     * @param area 需要比较的区域（像素，左右边界按整字节处理）
+     * @param changed 输出的变化区域
+     * @return 有像素变化返回true，否则返回false
+     */
+    static bool diffBuffers(uint8_t* prev, const uint8_t* next, size_t stride,
+                            const Rect& area, DirtyRegion& changed);
+
+private:
+    FrameDiff() = default;
+    ~FrameDiff();
+    FrameDiff(const FrameDiff&) = delete;
+    FrameDiff& operator=(const FrameDiff&) = delete;
+
+    /**
+     * @brief 按画布尺寸准备影子帧
+     * @return 影子帧可用返回true
+     */
+    bool ensureShadow(M5Canvas& canvas);
+
+    uint8_t* _shadow = nullptr;   ///< 上一次推送的帧（PSRAM）
+    size_t _shadowLength = 0;     ///< 影子帧字节数
+    size_t _stride = 0;           ///< 行跨度（字节）
+    int16_t _width = 0;           ///< 帧宽度
+    int16_t _height = 0;          ///< 帧高度
+    bool _valid = false;          ///< 影子帧是否与屏幕内容一致
+};
\ No newline at end of file
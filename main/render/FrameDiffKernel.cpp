@@ -0,0 +1,143 @@
+#include "FrameDiff.h"
+#include <cstring>
+#include <algorithm>
+
+// 差分内核不依赖M5GFX，主机构建中单独编译用于基准测试
+
+/**
+ * @brief 查找第一个不同的字节
+ * @return 字节下标，没有不同时返回length
+ */
+static size_t firstDifference(const uint8_t* prev, const uint8_t* next, size_t length) {
+    size_t i = 0;
+    if (((reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(next)) & 3) == 0) {
+        // 前导字节，直到对齐到32位
+        for (; i < length && (reinterpret_cast<uintptr_t>(next + i) & 3); i++) {
+            if (prev[i] != next[i]) {
+                return i;
+            }
+        }
+        // 按字比较，每次展开4个字
+        const uint32_t* p = reinterpret_cast<const uint32_t*>(prev + i);
+        const uint32_t* n = reinterpret_cast<const uint32_t*>(next + i);
+        size_t words = (length - i) / 4;
+        size_t w = 0;
+        for (; w + 4 <= words; w += 4) {
+            if ((p[w] ^ n[w]) | (p[w + 1] ^ n[w + 1]) | (p[w + 2] ^ n[w + 2]) | (p[w + 3] ^ n[w + 3])) {
+                break;
+            }
+        }
+        for (; w < words; w++) {
+            if (p[w] != n[w]) {
+                break;
+            }
+        }
+        i += w * 4;
+    }
+    // 在不同的字内或剩余字节中定位
+    for (; i < length; i++) {
+        if (prev[i] != next[i]) {
+            return i;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief 查找最后一个不同的字节（调用前已确认存在不同）
+ * @param floor 已知第一个不同字节的下标
+ * @return 字节下标
+ */
+static size_t lastDifference(const uint8_t* prev, const uint8_t* next, size_t length, size_t floor) {
+    size_t end = length;
+    if (((reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(next)) & 3) == 0) {
+        // 尾部字节，直到结尾对齐到32位
+        for (; end > floor && (reinterpret_cast<uintptr_t>(next + end) & 3); end--) {
+            if (prev[end - 1] != next[end - 1]) {
+                return end - 1;
+            }
+        }
+        // 从后向前按字比较，每次展开4个字
+        while (end >= floor + 16) {
+            const uint32_t* p = reinterpret_cast<const uint32_t*>(prev + end - 16);
+            const uint32_t* n = reinterpret_cast<const uint32_t*>(next + end - 16);
+            if ((p[0] ^ n[0]) | (p[1] ^ n[1]) | (p[2] ^ n[2]) | (p[3] ^ n[3])) {
+                break;
+            }
+            end -= 16;
+        }
+        while (end >= floor + 4) {
+            const uint32_t* p = reinterpret_cast<const uint32_t*>(prev + end - 4);
+            const uint32_t* n = reinterpret_cast<const uint32_t*>(next + end - 4);
+            if (*p != *n) {
+                break;
+            }
+            end -= 4;
+        }
+    }
+    for (; end > floor; end--) {
+        if (prev[end - 1] != next[end - 1]) {
+            return end - 1;
+        }
+    }
+    return floor;
+}
+
+bool FrameDiff::diffBuffers(uint8_t* prev, const uint8_t* next, size_t stride,
+                            const Rect& area, DirtyRegion& changed) {
+    // 每字节两个像素（高半字节在前），左右边界扩展到整字节
+    size_t byteBegin = area.x / 2;
+    size_t byteEnd = std::min(stride, static_cast<size_t>(area.right() + 1) / 2);
+    if (area.isEmpty() || byteBegin >= byteEnd) {
+        return false;
+    }
+    size_t length = byteEnd - byteBegin;
+
+    bool anyChange = false;
+    bool inBand = false;
+    int16_t bandTop = 0;
+    int16_t bandBottom = 0;
+    int16_t minX = 0;
+    int16_t maxX = 0;
+
+    for (int16_t y = area.y; y < area.bottom(); y++) {
+        uint8_t* prevRow = prev + y * stride + byteBegin;
+        const uint8_t* nextRow = next + y * stride + byteBegin;
+
+        size_t first = firstDifference(prevRow, nextRow, length);
+        if (first == length) {
+            continue;
+        }
+        size_t last = lastDifference(prevRow, nextRow, length, first);
+
+        // 精确到像素：高半字节是左侧像素
+        uint8_t firstXor = prevRow[first] ^ nextRow[first];
+        uint8_t lastXor = prevRow[last] ^ nextRow[last];
+        int16_t left = static_cast<int16_t>((byteBegin + first) * 2 + ((firstXor & 0xF0) ? 0 : 1));
+        int16_t right = static_cast<int16_t>((byteBegin + last) * 2 + ((lastXor & 0x0F) ? 1 : 0));
+
+        // 变化的字节同步到旧帧
+        memcpy(prevRow + first, nextRow + first, last - first + 1);
+
+        if (inBand && y - bandBottom > MERGE_GAP_ROWS) {
+            changed.add(Rect{minX, bandTop, static_cast<int16_t>(maxX - minX + 1), static_cast<int16_t>(bandBottom - bandTop + 1)});
+            inBand = false;
+        }
+        if (!inBand) {
+            inBand = true;
+            bandTop = y;
+            minX = left;
+            maxX = right;
+        } else {
+            minX = std::min(minX, left);
+            maxX = std::max(maxX, right);
+        }
+        bandBottom = y;
+        anyChange = true;
+    }
+
+    if (inBand) {
+        changed.add(Rect{minX, bandTop, static_cast<int16_t>(maxX - minX + 1), static_cast<int16_t>(bandBottom - bandTop + 1)});
+    }
+    return anyChange;
+}
\ No newline at end of file
@@ -18,12 +18,6 @@ public:
 
 
 
-    /**
-     * @brief 重写绘制方法
-     * @param display 显示对象
-     */
-    virtual void draw(m5gfx::M5GFX& display) override;
-
     /**
      * @brief 重写触摸处理方法
      * @param x X坐标
@@ -38,4 +32,11 @@ public:
      */
     virtual std::string className() const override { return "Button"; }
 
+protected:
+    /**
+     * @brief 绘制文本和按钮边框
+     * @param display 显示对象
+     */
+    virtual void onDraw(DrawSurface& display) override;
+
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "Dialog.h"
 #include <algorithm>
 
-Dialog::Dialog(m5gfx::M5GFX& display)
+Dialog::Dialog(DrawSurface& display)
     : FrameLayout(0, 0), _display(display), _isShowing(false), 
       _titleView(nullptr), _messageView(nullptr) {
     // 初始化按钮状态
@@ -60,7 +60,7 @@ void Dialog::setButton(ButtonId buttonId, const std::string& text) {
 }
 
 void Dialog::setOnButtonClickListener(OnButtonClickListener listener) {
-    _buttonClickListener = listener;
+    _buttonClickListener = std::move(listener);
 }
 
 void Dialog::show() {
@@ -130,13 +130,16 @@ bool Dialog::isShowing() const {
     return _isShowing;
 }
 
-void Dialog::draw(m5gfx::M5GFX& display) {
+void Dialog::draw(DrawSurface& display) {
     if (_isShowing) {
         // 绘制半透明遮罩
         display.fillRect(0, 0, display.width(), display.height(), 0x80000000 | (TFT_BLACK & 0xFFFFFF));
         
         // 绘制对话框本身
         FrameLayout::draw(display);
+    } else {
+        // 未显示时不绘制，丢弃脏标记以免父视图一直需要重绘
+        clearDirty();
     }
 }
 
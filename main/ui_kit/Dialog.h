@@ -3,7 +3,7 @@
 #include "FrameLayout.h"
 #include "Button.h"
 #include "TextView.h"
-#include <functional>
+#include "InlineFunction.h"
 
 /**
  * @brief Dialog - 对话框控件
@@ -15,7 +15,7 @@ public:
     /**
      * @brief 对话框按钮点击回调类型
      */
-    typedef std::function<void(int buttonId)> OnButtonClickListener;
+    typedef InlineFunction<void(int buttonId)> OnButtonClickListener;
 
     /**
      * @brief 按钮ID枚举
@@ -30,7 +30,7 @@ public:
      * @brief 构造函数
      * @param display 显示对象引用
      */
-    Dialog(m5gfx::M5GFX& display);
+    Dialog(DrawSurface& display);
 
     /**
      * @brief 设置对话框标题
@@ -77,7 +77,7 @@ public:
      * @brief 重写绘制方法
      * @param display 显示对象
      */
-    virtual void draw(m5gfx::M5GFX& display) override;
+    virtual void draw(DrawSurface& display) override;
 
     /**
      * @brief 重写触摸处理方法
@@ -90,7 +90,7 @@ public:
     std::string className() const override { return "Dialog"; }
 
 private:
-    m5gfx::M5GFX& _display;                    ///< 显示对象引用
+    DrawSurface& _display;                    ///< 显示对象引用
     std::string _title;                        ///< 标题
     std::string _message;                      ///< 消息
     std::string _buttonTexts[3];               ///< 按钮文本
@@ -0,0 +1,85 @@
+#include "DirtyRegion.h"
+#include <climits>
+
+bool DirtyRegion::shouldMerge(const Rect& a, const Rect& b) {
+    if (a.intersects(b)) {
+        return true;
+    }
+    // 相邻的矩形（例如列表中相邻的两行）合并后几乎没有额外面积
+    int32_t sum = a.area() + b.area();
+    return a.united(b).area() <= sum + sum / 4;
+}
+
+void DirtyRegion::removeAt(size_t index) {
+    _rects[index] = _rects[_count - 1];
+    _count--;
+}
+
+void DirtyRegion::add(const Rect& rect) {
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    Rect pending = rect;
+    // 反复与已有区域合并，直到没有可以合并的区域
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < _count; i++) {
+            if (_rects[i].contains(pending)) {
+                return;
+            }
+            if (shouldMerge(_rects[i], pending)) {
+                pending = pending.united(_rects[i]);
+                removeAt(i);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (_count < MAX_RECTS) {
+        _rects[_count++] = pending;
+        return;
+    }
+
+    // 区域已满：与合并后面积增长最小的区域合并
+    size_t best = 0;
+    int32_t bestCost = INT32_MAX;
+    for (size_t i = 0; i < _count; i++) {
+        int32_t cost = _rects[i].united(pending).area() - _rects[i].area();
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = i;
+        }
+    }
+    Rect combined = _rects[best].united(pending);
+    removeAt(best);
+    add(combined);
+}
+
+void DirtyRegion::add(const DirtyRegion& other) {
+    for (const Rect& rect : other) {
+        add(rect);
+    }
+}
+
+Rect DirtyRegion::bounds() const {
+    Rect result;
+    for (size_t i = 0; i < _count; i++) {
+        result = result.united(_rects[i]);
+    }
+    return result;
+}
+
+void DirtyRegion::clipTo(const Rect& clip) {
+    size_t i = 0;
+    while (i < _count) {
+        _rects[i] = _rects[i].intersected(clip);
+        if (_rects[i].isEmpty()) {
+            removeAt(i);
+        } else {
+            i++;
+        }
+    }
+}
\ No newline at end of file
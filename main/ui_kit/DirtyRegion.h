@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Rect.h"
+#include <cstddef>
+
+/**
+ * @brief DirtyRegion - 脏区域集合
+ *
+ * 收集视图树上报的损坏矩形，并合并为少量的屏幕更新区域。
+ * 相交或合并代价很小的矩形会被合并，超出上限时与合并后面积增长最小的矩形合并。
+ */
+class DirtyRegion {
+public:
+    static const size_t MAX_RECTS = 4;  ///< 最多保留的更新区域数量
+
+    /**
+     * @brief 添加一个损坏矩形
+     * @param rect 矩形区域，空矩形会被忽略
+     */
+    void add(const Rect& rect);
+
+    /**
+     * @brief 合并另一个脏区域的所有矩形
+     * @param other 另一个脏区域
+     */
+    void add(const DirtyRegion& other);
+
+    /**
+     * @brief 清空所有区域
+     */
+    void clear() { _count = 0; }
+
+    /**
+     * @brief 是否为空
+     */
+    bool isEmpty() const { return _count == 0; }
+
+    /**
+     * @brief 获取区域数量
+     */
+    size_t size() const { return _count; }
+
+    /**
+     * @brief 获取指定索引的区域
+     */
+    const Rect& operator[](size_t index) const { return _rects[index]; }
+
+    const Rect* begin() const { return _rects; }
+    const Rect* end() const { return _rects + _count; }
+
+    /**
+     * @brief 获取包含所有区域的最小矩形
+     */
+    Rect bounds() const;
+
+    /**
+     * @brief 将所有区域裁剪到指定范围内
+     * @param clip 裁剪范围（通常为屏幕尺寸）
+     */
+    void clipTo(const Rect& clip);
+
+private:
+    /**
+     * @brief 判断两个矩形是否值得合并（相交，或合并后面积增长不超过1/4）
+     */
+    static bool shouldMerge(const Rect& a, const Rect& b);
+
+    /**
+     * @brief 移除指定索引的区域
+     */
+    void removeAt(size_t index);
+
+    Rect _rects[MAX_RECTS];  ///< 更新区域
+    size_t _count = 0;       ///< 当前区域数量
+};
\ No newline at end of file
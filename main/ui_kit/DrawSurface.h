@@ -0,0 +1,13 @@
+#pragma once
+
+#include "M5GFX.h"
+
+/**
+ * @brief DrawSurface - 视图的绘制表面
+ * 
+ * 所有视图都绘制到DrawSurface上，不依赖具体的显示设备。
+ * 屏幕（M5GFX）和内存帧缓冲（M5Canvas，见render/FrameBufferSurface.h）
+ * 都派生自LovyanGFX，提供相同的绘图和文字接口。
+ * 主机构建（host/）中使用M5GFX的SDL桌面移植，视图代码无需改动。
+ */
+using DrawSurface = m5gfx::LovyanGFX;
\ No newline at end of file
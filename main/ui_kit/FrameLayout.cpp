@@ -4,8 +4,8 @@ FrameLayout::FrameLayout(int16_t width, int16_t height)
     : ViewGroup(width, height) {
 }
 
-void FrameLayout::layout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
-    ViewGroup::layout(left, top, right, bottom);
+void FrameLayout::onLayout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    ViewGroup::onLayout(left, top, right, bottom);
 
     // 所有子视图都放在FrameLayout的左上角，占据整个空间
     for (auto child : _children) {
@@ -15,12 +15,12 @@ void FrameLayout::layout(int16_t left, int16_t top, int16_t right, int16_t botto
     }
 }
 
-void FrameLayout::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void FrameLayout::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 首先测量自己
-    View::measure(widthMeasureSpec, heightMeasureSpec);
+    View::onMeasure(surface, widthMeasureSpec, heightMeasureSpec);
 
     // 测量子视图
     for (auto child : _children) {
-        child->measure(_width, _height);
+        child->measure(surface, _width, _height);
     }
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 默认的内联存储大小：足够放下[this]、几个指针或一个函数指针
+ */
+static constexpr size_t INLINE_FUNCTION_CAPACITY = 4 * sizeof(void*);
+
+template <typename Signature, size_t Capacity = INLINE_FUNCTION_CAPACITY>
+class InlineFunction;
+
+/**
+ * @brief InlineFunction - 固定容量、不申请堆内存的可调用对象
+ *
+ * 用于UI控件的回调，替代std::function：捕获的内容直接存放在对象内部，
+ * 构造和调用都不会访问堆；捕获超过Capacity时编译失败，而不是悄悄退回堆分配。
+ * 只能移动，不能复制。
+ *
+ * 用法与std::function相同：
+ * @code
+ * InlineFunction<void(int)> callback = [this](int index) { onItem(index); };
+ * @endcode
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief 从可调用对象构造
+     * @param fn 函数指针、lambda或仿函数
+     */
+    template <typename F, typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<!std::is_same<Fn, InlineFunction>::value>::type>
+    InlineFunction(F&& fn) {
+        static_assert(sizeof(Fn) <= Capacity, "Callable capture is too large for InlineFunction, capture less or raise Capacity");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over-aligned for InlineFunction");
+        static_assert(std::is_nothrow_move_constructible<Fn>::value, "Callable must be nothrow move constructible");
+        if (isNull<Fn>(fn)) {
+            return;
+        }
+        new (_storage) Fn(std::forward<F>(fn));
+        _invoke = &invokeImpl<Fn>;
+        _manage = &manageImpl<Fn>;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept { moveFrom(other); }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename F, typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<!std::is_same<Fn, InlineFunction>::value>::type>
+    InlineFunction& operator=(F&& fn) {
+        return *this = InlineFunction(std::forward<F>(fn));
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    /**
+     * @brief 是否持有可调用对象
+     */
+    explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+    /**
+     * @brief 调用（为空时行为未定义，调用前应检查）
+     */
+    R operator()(Args... args) const {
+        return _invoke(const_cast<unsigned char*>(_storage), std::forward<Args>(args)...);
+    }
+
+private:
+    enum class Operation { MOVE, DESTROY };
+
+    template <typename Fn>
+    static R invokeImpl(void* storage, Args&&... args) {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Fn>
+    static void manageImpl(Operation operation, void* dst, void* src) {
+        if (operation == Operation::MOVE) {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+        }
+        static_cast<Fn*>(src)->~Fn();
+    }
+
+    template <typename Fn>
+    static bool isNull(const Fn& fn) {
+        return isNullImpl<Fn>(fn, 0);
+    }
+
+    // 空的函数指针按空回调处理，与std::function一致
+    template <typename Fn>
+    static auto isNullImpl(const Fn& fn, int) -> decltype(fn == nullptr) {
+        return fn == nullptr;
+    }
+
+    template <typename Fn>
+    static bool isNullImpl(const Fn&, long) {
+        return false;
+    }
+
+    void moveFrom(InlineFunction& other) noexcept {
+        if (other._invoke != nullptr) {
+            other._manage(Operation::MOVE, _storage, other._storage);
+            _invoke = other._invoke;
+            _manage = other._manage;
+            other._invoke = nullptr;
+            other._manage = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (_invoke != nullptr) {
+            _manage(Operation::DESTROY, nullptr, _storage);
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char _storage[Capacity];  ///< 内联存储
+    R (*_invoke)(void*, Args&&...) = nullptr;                      ///< 调用入口
+    void (*_manage)(Operation, void*, void*) = nullptr;            ///< 移动和析构
+};
\ No newline at end of file
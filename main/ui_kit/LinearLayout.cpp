@@ -9,14 +9,14 @@ LinearLayout::LinearLayout(int16_t width, int16_t height, Orientation orientatio
 void LinearLayout::setOrientation(Orientation orientation) {
     if(_orientation != orientation) {
         _orientation = orientation;
-        markDirty();
+        requestLayout();
     }    
 }
 
 void LinearLayout::setSpacing(int16_t spacing) {
     if(_spacing != spacing) {
         _spacing = spacing;
-        markDirty();
+        requestLayout();
     }    
 }
 
@@ -74,42 +74,16 @@ void LinearLayout::onLayout(int16_t left, int16_t top, int16_t right, int16_t bo
     }
 }
 
-void LinearLayout::draw(m5gfx::M5GFX& display) {
-    if (_visibility == GONE) {
-        return;
-    }
-
-    // 只有当自身或子视图需要重绘时才进行绘制
-    if (isDirty()) {
-        // 确保视图组已正确布局
-        layout(_left, _top, _left + _width, _top + _height);
-
-        // 绘制自身（背景、边框等）- 使用View的绘制方法
-        View::draw(display);
-
-        // 绘制所有可见的子视图
-        for (auto child : _children) {
-            if (child->getVisibility() != GONE) {
-                // 确保子视图只在内容区域内绘制
-                child->draw(display);
-            }
-        }
-        
-        // 标记为已绘制，清除脏标记
-        _isDirty = false;
-    }
-}
-
-void LinearLayout::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void LinearLayout::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 首先测量自己
-    View::measure(widthMeasureSpec, heightMeasureSpec);
+    View::onMeasure(surface, widthMeasureSpec, heightMeasureSpec);
 
     // 测量子视图
     for (auto child : _children) {
         // 对于LinearLayout，在布局方向上不限制子视图的尺寸，只限制垂直方向
         // if (_orientation == VERTICAL) {
             // 垂直布局：限制子视图的宽度，但不限制高度
-            child->measure(std::min<int16_t>(widthMeasureSpec, child->getWidth()), std::min<int16_t>(heightMeasureSpec, child->getHeight()));  // 0表示无限制
+            child->measure(surface, std::min<int16_t>(widthMeasureSpec, child->getWidth()), std::min<int16_t>(heightMeasureSpec, child->getHeight()));  // 0表示无限制
         // } else {
         //     // 水平布局：限制子视图的高度，但不限制宽度
         //     child->measure(0, _height);  // 0表示无限制
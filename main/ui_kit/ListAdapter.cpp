@@ -0,0 +1,56 @@
+#include "ListAdapter.h"
+#include <algorithm>
+
+// 统计总数时每次加载的项目数
+static const int COUNT_PAGE_SIZE = 32;
+
+int LoaderListAdapter::count() {
+    if (_count >= 0) {
+        return _count;
+    }
+    // 旧接口没有总数，逐页加载直到不足一页
+    int total = 0;
+    if (_loader) {
+        for (int page = 0;; page++) {
+            std::vector<std::string> items = _loader(page, COUNT_PAGE_SIZE);
+            total += items.size();
+            if ((int)items.size() < COUNT_PAGE_SIZE) {
+                break;
+            }
+        }
+    }
+    _count = total;
+    return _count;
+}
+
+int LoaderListAdapter::getRange(int offset, int n, ItemList& out) {
+    out.clear();
+    if (!_loader || n <= 0 || offset < 0) {
+        return 0;
+    }
+    if (offset % n == 0) {
+        _window = _loader(offset / n, n);
+    } else {
+        // 不按页对齐时加载覆盖该范围的两页
+        int page = offset / n;
+        _window = _loader(page, n);
+        std::vector<std::string> next = _loader(page + 1, n);
+        _window.insert(_window.end(), next.begin(), next.end());
+        int skip = std::min((int)_window.size(), offset - page * n);
+        _window.erase(_window.begin(), _window.begin() + skip);
+        if ((int)_window.size() > n) {
+            _window.resize(n);
+        }
+    }
+    out.reserve(_window.size());
+    for (const std::string& item : _window) {
+        out.push_back(item.c_str());
+    }
+    return out.size();
+}
+
+void LoaderListAdapter::notifyDataSetChanged() {
+    _count = -1;
+    _window.clear();
+    ListAdapter::notifyDataSetChanged();
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "InlineFunction.h"
+#include "memory/MemoryPolicy.h"
+
+/**
+ * @brief ListAdapter - 分页列表的随机访问数据源
+ *
+ * 列表只按需读取当前页范围内的项目，翻页的开销只与每页项目数有关。
+ * 返回的是指向数据源内部字符串的指针，不复制字符串；数据变化后
+ * 数据源必须调用notifyDataSetChanged()，之前返回的指针随即失效。
+ */
+class ListAdapter {
+public:
+    /**
+     * @brief 数据变化回调类型
+     */
+    typedef InlineFunction<void()> OnDataSetChangedListener;
+
+    /**
+     * @brief 一段项目文本（每次绘制都会访问，放在内部SRAM）
+     */
+    typedef InternalVector<const char*> ItemList;
+
+    virtual ~ListAdapter() = default;
+
+    /**
+     * @brief 获取项目总数
+     * @return 项目总数
+     */
+    virtual int count() = 0;
+
+    /**
+     * @brief 获取一段连续范围内的项目
+     * @param offset 起始索引
+     * @param n 最多获取的项目数
+     * @param out 输出以'\0'结尾的项目文本，指针在下次数据变化前有效
+     * @return 实际获取的项目数
+     */
+    virtual int getRange(int offset, int n, ItemList& out) = 0;
+
+    /**
+     * @brief 通知列表数据已变化（在UI任务中调用）
+     */
+    virtual void notifyDataSetChanged() {
+        if (_listener) {
+            _listener();
+        }
+    }
+
+    /**
+     * @brief 设置数据变化回调（由列表视图设置）
+     * @param listener 回调函数
+     */
+    void setOnDataSetChangedListener(OnDataSetChangedListener listener) { _listener = std::move(listener); }
+
+private:
+    OnDataSetChangedListener _listener;  ///< 数据变化回调
+};
+
+/**
+ * @brief LoaderListAdapter - 兼容按页加载回调的数据源
+ *
+ * 包装旧的DataSourceLoader：总数在数据变化后只统计一次并缓存，
+ * 之后翻页只调用一次加载回调读取当前页。
+ */
+class LoaderListAdapter : public ListAdapter {
+public:
+    /**
+     * @brief 按页加载回调类型
+     */
+    typedef InlineFunction<std::vector<std::string>(int page, int pageSize)> Loader;
+
+    /**
+     * @brief 构造函数
+     * @param loader 按页加载回调
+     */
+    explicit LoaderListAdapter(Loader loader) : _loader(std::move(loader)) {}
+
+    virtual int count() override;
+    virtual int getRange(int offset, int n, ItemList& out) override;
+    virtual void notifyDataSetChanged() override;
+
+private:
+    Loader _loader;                    ///< 按页加载回调
+    int _count = -1;                   ///< 缓存的总数，-1表示需要重新统计
+    std::vector<std::string> _window;  ///< 最近一次加载的页，getRange返回的指针指向这里
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ListView.h"
 #include "TextView.h"
+#include "TextEllipsizer.h"
 
 ListView::ListView(int16_t width, int16_t height)
     : ViewGroup(width, height), _rowCount(5), _scrollOffset(0), _itemClickListener(nullptr) {
@@ -51,16 +52,13 @@ int16_t ListView::getScrollOffset() const {
 }
 
 void ListView::setOnItemClickListener(OnItemClickListener listener) {
-    _itemClickListener = listener;
+    _itemClickListener = std::move(listener);
 }
 
-void ListView::draw(m5gfx::M5GFX& display) {
-    if (_visibility == GONE) {
-        return;
-    }
-
+void ListView::onDraw(DrawSurface& display) {
+    TextEllipsizer& ellipsizer = TextEllipsizer::getInstance();
     // 绘制背景
-    View::draw(display);
+    View::onDraw(display);
 
     if (_visibility == VISIBLE) {
         // 计算每项的高度
@@ -87,46 +85,12 @@ void ListView::draw(m5gfx::M5GFX& display) {
                     display.setTextColor(TFT_BLACK);
                     display.setTextSize(1);
                     
-                    // 检查文本是否过长需要截断
-                     std::string text = _items[i];
-                     int16_t text_width = display.textWidth(text.c_str());
-                     int16_t max_width = _width - _paddingLeft - _paddingRight; // 考虑左右padding
-                     
-                     if (text_width > max_width) {
-                         // 需要截断文本并添加省略号
-                         std::string ellipsis = "...";                         
-                         
-                         // 如果原始文本适合空间，直接使用
-                          if (display.textWidth(text.c_str()) <= max_width) {
-                              // 文本适合空间，无需处理
-                          } else {
-                              // 使用二分查找来快速找到合适的文本长度
-                              int left = 0;
-                              int right = text.length();
-                              std::string result = ellipsis; // 默认结果是省略号
-                              
-                              while (left <= right) {
-                                  int mid = left + (right - left) / 2;
-                                  std::string substr = text.substr(0, mid);
-                                  std::string candidate = substr + ellipsis;
-                                  
-                                  if (display.textWidth(candidate.c_str()) <= max_width) {
-                                      result = candidate;
-                                      left = mid + 1;
-                                  } else {
-                                      right = mid - 1;
-                                  }
-                              }
-                              
-                              text = result;
-                          }
-                     }
-                    
-                    // 使用padding调整文本位置
+                    // 使用padding调整文本位置，过长的文本按字符边界截断并添加省略号
+                    int16_t max_width = _width - _paddingLeft - _paddingRight; // 考虑左右padding
                     int16_t textX = _left + _paddingLeft;
                     int16_t textY = yPos + (itemHeight - display.fontHeight()) / 2;
                     display.setCursor(textX, textY);
-                    display.print(text.c_str());
+                    ellipsizer.print(display, _items[i], max_width);
                     
                     // 绘制分割线
                     if (yPos + itemHeight < _top + _height) {
@@ -168,7 +132,7 @@ bool ListView::onTouch(int16_t x, int16_t y) {
     return false;
 }
 
-void ListView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void ListView::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 如果指定了具体尺寸，则使用指定尺寸；否则使用父容器提供的约束
     if (_width <= 0 && widthMeasureSpec > 0) {
         _width = widthMeasureSpec;
@@ -179,9 +143,6 @@ void ListView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
 }
 
 void ListView::layout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
-    // 使用父容器指定的布局参数
-    _left = left;
-    _top = top;
-    _width = right - left;
-    _height = bottom - top;
+    // 使用父容器指定的布局参数，位置或尺寸变化时记录脏区域
+    View::layout(left, top, right, bottom);
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "ViewGroup.h"
 #include <vector>
-#include <functional>
+#include "InlineFunction.h"
 
 /**
  * @brief ListView - 列表视图
@@ -14,7 +14,7 @@ public:
     /**
      * @brief 项目点击回调类型
      */
-    typedef std::function<void(int index)> OnItemClickListener;
+    typedef InlineFunction<void(int index)> OnItemClickListener;
 
     /**
      * @brief 构造函数
@@ -65,12 +65,6 @@ public:
      */
     void setOnItemClickListener(OnItemClickListener listener);
 
-    /**
-     * @brief 重写绘制方法
-     * @param display 显示对象
-     */
-    virtual void draw(m5gfx::M5GFX& display) override;
-
     /**
      * @brief 重写触摸处理方法
      * @param x X坐标
@@ -79,13 +73,6 @@ public:
      */
     virtual bool onTouch(int16_t x, int16_t y) override;
 
-    /**
-     * @brief 重写测量方法
-     * @param widthMeasureSpec 父容器提供的宽度约束
-     * @param heightMeasureSpec 父容器提供的高度约束
-     */
-    virtual void measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
-
     /**
      * @brief 重写布局方法
      * @param left 左边界
@@ -101,6 +88,21 @@ public:
      */
     virtual std::string className() const override { return "ListView"; }
 
+protected:
+    /**
+     * @brief 重写测量方法
+     * @param surface 视图所在的绘制表面（用于测量文字）
+     * @param widthMeasureSpec 父容器提供的宽度约束
+     * @param heightMeasureSpec 父容器提供的高度约束
+     */
+    virtual void onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+
+    /**
+     * @brief 绘制列表内容
+     * @param display 显示对象
+     */
+    virtual void onDraw(DrawSurface& display) override;
+
 private:
     std::vector<std::string> _items;           ///< 数据项列表
     int16_t _rowCount;                         ///< 显示行数
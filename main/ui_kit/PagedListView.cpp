@@ -1,5 +1,7 @@
 #include "PagedListView.h"
 #include "TextView.h"
+#include "TextMetricsCache.h"
+#include "TextEllipsizer.h"
 #include "esp_log.h"
 #include <algorithm>
 #include <cmath>
@@ -13,7 +15,7 @@ PagedListView::PagedListView(int16_t width, int16_t height)
       _currentPage(0),
       _totalPages(0),
       _totalItems(0),
-      _dataSourceLoader(nullptr),
+      _adapter(nullptr),
       _itemRenderer(nullptr),
       _itemClickListener(nullptr),
       _pageChangeListener(nullptr),
@@ -23,10 +25,17 @@ PagedListView::PagedListView(int16_t width, int16_t height)
     ESP_LOGD("PagedListView", "created with width=%d, height=%d", width, height);
 }
 
+PagedListView::~PagedListView() {
+    // 数据源可能比列表活得更久，不能再回调到这里
+    if (_adapter) {
+        _adapter->setOnDataSetChangedListener(nullptr);
+    }
+}
+
 void PagedListView::setRowCount(int16_t rowCount) {
     if (rowCount > 0) {
         _rowCount = rowCount;
-        refreshData();
+        _onDataSetChanged();
     }
 }
 
@@ -37,7 +46,7 @@ int16_t PagedListView::getRowCount() const {
 void PagedListView::setColumnCount(int16_t columnCount) {
     if (columnCount > 0) {
         _columnCount = columnCount;
-        refreshData();
+        _onDataSetChanged();
     }
 }
 
@@ -45,25 +54,35 @@ int16_t PagedListView::getColumnCount() const {
     return _columnCount;
 }
 
+void PagedListView::setAdapter(std::shared_ptr<ListAdapter> adapter) {
+    if (_adapter) {
+        _adapter->setOnDataSetChangedListener(nullptr);
+    }
+    _adapter = adapter;
+    if (_adapter) {
+        _adapter->setOnDataSetChangedListener([this]() { _onDataSetChanged(); });
+    }
+    _onDataSetChanged();
+}
+
 void PagedListView::setDataSourceLoader(DataSourceLoader loader) {
-    _dataSourceLoader = loader;
-    refreshData();
+    setAdapter(loader ? std::make_shared<LoaderListAdapter>(std::move(loader)) : nullptr);
 }
 
 void PagedListView::setItemRenderer(ItemRenderer renderer) {
-    _itemRenderer = renderer;
+    _itemRenderer = std::move(renderer);
 }
 
 void PagedListView::setOnItemClickListener(OnItemClickListener listener) {
-    _itemClickListener = listener;
+    _itemClickListener = std::move(listener);
 }
 
 void PagedListView::setOnPageChangeListener(OnPageChangeListener listener) {
-    _pageChangeListener = listener;
+    _pageChangeListener = std::move(listener);
 }
 
 void PagedListView::setOnBackCallback(OnBackCallback callback) {
-    _backCallback = callback;
+    _backCallback = std::move(callback);
 }
 
 void PagedListView::setTotalItems(int totalItems) {
@@ -76,7 +95,7 @@ int PagedListView::getTotalItems() const {
 }
 
 void PagedListView::setCurrentPage(int page) {
-    if (!_dataSourceLoader) {
+    if (!_adapter) {
         return;
     }
 
@@ -110,12 +129,21 @@ int PagedListView::getTotalPages() const {
 }
 
 void PagedListView::refreshData() {
-    if (!_dataSourceLoader) {
+    if (!_adapter) {
         return;
     }
-    
-    // 先获取总项目数，这里我们假设通过尝试加载第一页来估算总数
-    // 实际应用中可能需要额外的API来获取总数
+    // 数据源会回调_onDataSetChanged重新加载
+    _adapter->notifyDataSetChanged();
+}
+
+void PagedListView::_onDataSetChanged() {
+    if (!_adapter) {
+        _currentPageItems.clear();
+        return;
+    }
+    // 总数只在数据变化时读取一次，翻页不再重新统计
+    _updatePageCount();
+    _currentPage = std::max(0, std::min(_currentPage, _totalPages - 1));
     _loadCurrentPageData();
     markDirty();
 }
@@ -136,56 +164,26 @@ bool PagedListView::prevPage() {
     return false;
 }
 
-void PagedListView::_calculatePageSize() {
-    if (!_dataSourceLoader) {
-        _totalPages = 0;
-        _totalItems = 0;
-        return;
-    }
-
-    // 估算总项目数 - 这里需要改进，实际应用中应该有专门的方法获取总数
-    int pageSize = _rowCount * _columnCount;
-    int page = 0;
-    int total = 0;
-    
-    // 尝试加载多个页面来计算总数（这是一个简化实现）
-    // 在实际应用中，您可能需要一个单独的API来获取总项目数
-    while (true) {
-        auto items = _dataSourceLoader(page, pageSize);
-        if (items.empty()) {
-            break;
-        }
-        total += items.size();
-        if (items.size() < pageSize) {
-            // 如果返回的项目数少于页面大小，说明这是最后一页
-            break;
-        }
-        page++;
-    }
-    
-    _totalItems = total;
-    _totalPages = pageSize > 0 ? (total + pageSize - 1) / pageSize : 0;
+void PagedListView::_updatePageCount() {
+    setTotalItems(_adapter ? _adapter->count() : 0);
 }
 
 void PagedListView::_loadCurrentPageData() {
-    if (!_dataSourceLoader) {
+    if (!_adapter) {
         _currentPageItems.clear();
         return;
     }
 
-    _calculatePageSize();
-    
+    // 只读取当前页范围内的项目
     int pageSize = _rowCount * _columnCount;
-    _currentPageItems = _dataSourceLoader(_currentPage, pageSize);
+    _adapter->getRange(_currentPage * pageSize, pageSize, _currentPageItems);
 }
 
-void PagedListView::draw(m5gfx::M5GFX& display) {
-    if (_visibility == GONE) {
-        return;
-    }
-
+void PagedListView::onDraw(DrawSurface& display) {
+    TextMetricsCache& metrics = TextMetricsCache::getInstance();
+    TextEllipsizer& ellipsizer = TextEllipsizer::getInstance();
     // 绘制背景
-    View::draw(display);
+    View::onDraw(display);
 
     if (_visibility == VISIBLE && _parent != nullptr) {
         int itemCount = _currentPageItems.size();        
@@ -220,38 +218,11 @@ void PagedListView::draw(m5gfx::M5GFX& display) {
                 display.setTextSize(1);
                 
                 // 简单的文本绘制，带省略号处理
-                std::string text = _currentPageItems[i];
-                int16_t text_width = display.textWidth(text.c_str());
                 int16_t max_width = itemW - 10; // 考虑内边距
-                
-                if (text_width > max_width && max_width > 0) {
-                    std::string ellipsis = "...";
-                    int16_t ellipsis_width = display.textWidth(ellipsis.c_str());
-                    
-                    int left = 0;
-                    int right = text.length();
-                    std::string result = ellipsis;
-                    
-                    while (left <= right && max_width > ellipsis_width) {
-                        int mid = left + (right - left) / 2;
-                        std::string substr = text.substr(0, mid);
-                        std::string candidate = substr + ellipsis;
-                        
-                        if (display.textWidth(candidate.c_str()) <= max_width) {
-                            result = candidate;
-                            left = mid + 1;
-                        } else {
-                            right = mid - 1;
-                        }
-                    }
-                    
-                    text = result;
-                }
-                
                 int16_t textX = itemX + 5;
                 int16_t textY = itemY + (itemH - display.fontHeight()) / 2;
                 display.setCursor(textX, textY);
-                display.print(text.c_str());
+                ellipsizer.print(display, _currentPageItems[i], max_width);
             }
         }
         
@@ -275,13 +246,13 @@ void PagedListView::draw(m5gfx::M5GFX& display) {
         display.drawRect(prevButtonX, prevButtonY, buttonWidth, buttonHeight, TFT_BLACK);
         display.setTextColor(TFT_BLACK);
         display.setTextSize(1);
-        display.setCursor(prevButtonX + (buttonWidth - display.textWidth("上一页")) / 2, 
+        display.setCursor(prevButtonX + (buttonWidth - metrics.textWidth(display, "上一页")) / 2, 
                          prevButtonY + (buttonHeight - display.fontHeight()) / 2);
         display.print("上一页");
         
         // 页码信息
         std::string pageInfo = "第 " + std::to_string(_currentPage + 1) + "/" + std::to_string(_totalPages) + " 页";
-        int16_t pageInfoWidth = display.textWidth(pageInfo.c_str());
+        int16_t pageInfoWidth = metrics.textWidth(display, pageInfo.c_str());
         int16_t pageInfoX = _left + padding + buttonWidth + padding;
         int16_t pageInfoY = controlBarY + (controlBarHeight - display.fontHeight()) / 2;
         display.setCursor(pageInfoX, pageInfoY);
@@ -300,7 +271,7 @@ void PagedListView::draw(m5gfx::M5GFX& display) {
         display.fillRect(nextButtonX, nextButtonY, buttonWidth, buttonHeight, TFT_WHITE);
         display.drawRect(nextButtonX, nextButtonY, buttonWidth, buttonHeight, TFT_BLACK);
         display.setTextColor(TFT_BLACK);
-        display.setCursor(nextButtonX + (buttonWidth - display.textWidth("下一页")) / 2, 
+        display.setCursor(nextButtonX + (buttonWidth - metrics.textWidth(display, "下一页")) / 2, 
                          nextButtonY + (buttonHeight - display.fontHeight()) / 2);
         display.print("下一页");
         
@@ -310,7 +281,7 @@ void PagedListView::draw(m5gfx::M5GFX& display) {
         display.fillRect(backButtonX, backButtonY, buttonWidth, buttonHeight, TFT_WHITE);
         display.drawRect(backButtonX, backButtonY, buttonWidth, buttonHeight, TFT_BLACK);
         display.setTextColor(TFT_BLACK);
-        display.setCursor(backButtonX + (buttonWidth - display.textWidth("返回")) / 2, 
+        display.setCursor(backButtonX + (buttonWidth - metrics.textWidth(display, "返回")) / 2, 
                          backButtonY + (buttonHeight - display.fontHeight()) / 2);
         display.print("返回");
         
@@ -375,16 +346,24 @@ bool PagedListView::onTouch(int16_t x, int16_t y) {
     return false;
 }
 
-bool PagedListView::onSwipe(TouchGestureDetector::SwipeDirection direction) {
+bool PagedListView::onSwipe(TouchGestureDetector::SwipeDirection direction, int count) {
     switch (direction) {
         case TouchGestureDetector::SwipeDirection::LEFT:
         case TouchGestureDetector::SwipeDirection::UP:
-            // 向左滑动，跳转到下一页
-            return nextPage();
+            // 向左滑动，跳转到下一页（合并的多次滑动一次跳转到位）
+            if (_currentPage < _totalPages - 1) {
+                setCurrentPage(_currentPage + std::max(count, 1));
+                return true;
+            }
+            return false;
         case TouchGestureDetector::SwipeDirection::RIGHT:
         case TouchGestureDetector::SwipeDirection::DOWN:
             // 向右滑动，跳转到上一页
-            return prevPage();
+            if (_currentPage > 0) {
+                setCurrentPage(_currentPage - std::max(count, 1));
+                return true;
+            }
+            return false;
         default:
             // 其他方向不处理
             return false;
@@ -465,7 +444,7 @@ int16_t PagedListView::_getItemHeight() const {
 
 void PagedListView::setHorizontalSpacing(int16_t spacing) {
     _horizontalSpacing = spacing >= 0 ? spacing : 0;
-    refreshData();  // 重新计算布局
+    markDirty();  // 重新计算布局
 }
 
 int16_t PagedListView::getHorizontalSpacing() const {
@@ -474,7 +453,7 @@ int16_t PagedListView::getHorizontalSpacing() const {
 
 void PagedListView::setVerticalSpacing(int16_t spacing) {
     _verticalSpacing = spacing >= 0 ? spacing : 0;
-    refreshData();  // 重新计算布局
+    markDirty();  // 重新计算布局
 }
 
 int16_t PagedListView::getVerticalSpacing() const {
@@ -497,7 +476,7 @@ int PagedListView::_getIndexFromPosition(int16_t x, int16_t y) const {
     return -1;
 }
 
-void PagedListView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void PagedListView::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 如果指定了具体尺寸，则使用指定尺寸；否则使用父容器提供的约束
     if (_width <= 0 && widthMeasureSpec > 0) {
         _width = widthMeasureSpec;
@@ -508,9 +487,6 @@ void PagedListView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec)
 }
 
 void PagedListView::layout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
-    // 使用父容器指定的布局参数
-    _left = left;
-    _top = top;
-    _width = right - left;
-    _height = bottom - top;
+    // 使用父容器指定的布局参数，位置或尺寸变化时记录脏区域
+    View::layout(left, top, right, bottom);
 }
\ No newline at end of file
@@ -1,8 +1,9 @@
 #pragma once
 
 #include "ViewGroup.h"
+#include "ListAdapter.h"
 #include <vector>
-#include <functional>
+#include "InlineFunction.h"
 #include <memory>
 
 /**
@@ -15,28 +16,28 @@ public:
     /**
      * @brief 项目点击回调类型
      */
-    typedef std::function<void(int index)> OnItemClickListener;
+    typedef InlineFunction<void(int index)> OnItemClickListener;
 
     /**
-     * @brief 数据源加载回调类型
+     * @brief 数据源加载回调类型（兼容旧接口，由LoaderListAdapter包装）
      */
-    typedef std::function<std::vector<std::string>(int page, int pageSize)> DataSourceLoader;
+    typedef LoaderListAdapter::Loader DataSourceLoader;
 
     /**
-     * @brief 项目绘制回调类型
+     * @brief 项目绘制回调类型（item指向数据源内部的文本，接受const std::string&的旧回调仍可使用）
      */
-    typedef std::function<void(m5gfx::M5GFX& display, int index, const std::string& item, 
+    typedef InlineFunction<void(DrawSurface& display, int index, const char* item, 
                               int16_t x, int16_t y, int16_t width, int16_t height)> ItemRenderer;
 
     /**
      * @brief 页码变化回调类型
      */
-    typedef std::function<void(int currentPage, int totalPages)> OnPageChangeListener;
+    typedef InlineFunction<void(int currentPage, int totalPages)> OnPageChangeListener;
 
     /**
      * @brief 返回按钮点击回调类型
      */
-    typedef std::function<void()> OnBackCallback;
+    typedef InlineFunction<void()> OnBackCallback;
 
     /**
      * @brief 构造函数
@@ -45,6 +46,11 @@ public:
      */
     PagedListView(int16_t width, int16_t height);
 
+    /**
+     * @brief 析构函数，断开与数据源的连接
+     */
+    virtual ~PagedListView();
+
     /**
      * @brief 设置显示行数
      * @param rowCount 每页显示的行数
@@ -94,7 +100,19 @@ public:
     int16_t getVerticalSpacing() const;
 
     /**
-     * @brief 设置数据源加载器
+     * @brief 设置数据源
+     * @param adapter 数据源，数据变化时由数据源通知列表
+     */
+    void setAdapter(std::shared_ptr<ListAdapter> adapter);
+
+    /**
+     * @brief 获取数据源
+     * @return 数据源，未设置时为空
+     */
+    std::shared_ptr<ListAdapter> getAdapter() const { return _adapter; }
+
+    /**
+     * @brief 设置数据源加载器（兼容旧接口，内部包装为LoaderListAdapter）
      * @param loader 数据源加载回调函数
      */
     void setDataSourceLoader(DataSourceLoader loader);
@@ -154,7 +172,7 @@ public:
     int getTotalItems() const;
 
     /**
-     * @brief 刷新当前页数据
+     * @brief 数据已变化，通知数据源并重新加载当前页
      */
     void refreshData();
 
@@ -170,12 +188,6 @@ public:
      */
     bool prevPage();
 
-    /**
-     * @brief 重写绘制方法
-     * @param display 显示对象
-     */
-    virtual void draw(m5gfx::M5GFX& display) override;
-
     /**
      * @brief 重写触摸处理方法
      * @param x X坐标
@@ -187,16 +199,10 @@ public:
     /**
      * @brief 重写滑动处理方法
      * @param direction 滑动方向
+     * @param count 连续同向滑动的次数（刷新期间的滑动会被合并）
      * @return 如果处理了事件返回true，否则返回false
      */
-    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction) override;
-
-    /**
-     * @brief 重写测量方法
-     * @param widthMeasureSpec 父容器提供的宽度约束
-     * @param heightMeasureSpec 父容器提供的高度约束
-     */
-    virtual void measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction, int count = 1) override;
 
     /**
      * @brief 重写布局方法
@@ -213,6 +219,21 @@ public:
      */
     virtual std::string className() const override { return "PagedListView"; }
 
+protected:
+    /**
+     * @brief 重写测量方法
+     * @param surface 视图所在的绘制表面（用于测量文字）
+     * @param widthMeasureSpec 父容器提供的宽度约束
+     * @param heightMeasureSpec 父容器提供的高度约束
+     */
+    virtual void onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+
+    /**
+     * @brief 绘制列表内容
+     * @param display 显示对象
+     */
+    virtual void onDraw(DrawSurface& display) override;
+
 private:
     int16_t _rowCount;                           ///< 每页显示的行数
     int16_t _columnCount;                        ///< 每页显示的列数
@@ -221,14 +242,15 @@ private:
     int _currentPage;                            ///< 当前页码
     int _totalPages;                             ///< 总页数
     int _totalItems;                             ///< 总项目数
-    std::vector<std::string> _currentPageItems;  ///< 当前页的数据项
-    DataSourceLoader _dataSourceLoader;          ///< 数据源加载器
+    ListAdapter::ItemList _currentPageItems;     ///< 当前页的数据项（指向数据源内部）
+    std::shared_ptr<ListAdapter> _adapter;       ///< 数据源
     ItemRenderer _itemRenderer;                  ///< 项目渲染器
     OnItemClickListener _itemClickListener;      ///< 项目点击监听器
     OnPageChangeListener _pageChangeListener;    ///< 页码变化监听器
     OnBackCallback _backCallback;                ///< 返回按钮回调
     
-    void _calculatePageSize();
+    void _onDataSetChanged();
+    void _updatePageCount();
     void _loadCurrentPageData();
     int16_t _getItemX(int index) const;
     int16_t _getItemY(int index) const;
@@ -22,15 +22,15 @@ void QRCodeView::setQRCode(const std::string& qrcode)
     }    
 }
 
-void QRCodeView::onDraw(m5gfx::M5GFX& display)
+void QRCodeView::onDraw(DrawSurface& display)
 {
     if(_qrcode.empty()) {
         return;
     }
-    M5.Display.qrcode(_qrcode.c_str(), getLeft(), getTop(), getWidth(), 0, true);
+    display.qrcode(_qrcode.c_str(), getLeft(), getTop(), getWidth(), 0, true);
 }
 
-void QRCodeView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec)
+void QRCodeView::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec)
 {
     // 如果宽度或高度未设置，可以根据文本内容计算
     if (_width <= 0) {
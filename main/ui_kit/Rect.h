@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief Rect - 矩形区域
+ *
+ * 用于描述视图边界以及需要推送到屏幕的脏区域
+ */
+struct Rect {
+    int16_t x = 0;  ///< 左上角X坐标
+    int16_t y = 0;  ///< 左上角Y坐标
+    int16_t w = 0;  ///< 宽度
+    int16_t h = 0;  ///< 高度
+
+    /**
+     * @brief 是否为空矩形
+     * @return 宽或高不大于0时返回true
+     */
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+
+    /**
+     * @brief 获取右边界（不包含）
+     */
+    int16_t right() const { return x + w; }
+
+    /**
+     * @brief 获取下边界（不包含）
+     */
+    int16_t bottom() const { return y + h; }
+
+    /**
+     * @brief 获取面积
+     */
+    int32_t area() const { return isEmpty() ? 0 : (int32_t)w * h; }
+
+    /**
+     * @brief 是否与另一个矩形相交
+     */
+    bool intersects(const Rect& other) const {
+        if (isEmpty() || other.isEmpty()) {
+            return false;
+        }
+        return x < other.right() && other.x < right() && y < other.bottom() && other.y < bottom();
+    }
+
+    /**
+     * @brief 是否完整包含另一个矩形
+     */
+    bool contains(const Rect& other) const {
+        if (isEmpty() || other.isEmpty()) {
+            return false;
+        }
+        return other.x >= x && other.y >= y && other.right() <= right() && other.bottom() <= bottom();
+    }
+
+    /**
+     * @brief 计算包含两个矩形的最小矩形
+     */
+    Rect united(const Rect& other) const {
+        if (isEmpty()) {
+            return other;
+        }
+        if (other.isEmpty()) {
+            return *this;
+        }
+        int16_t l = std::min(x, other.x);
+        int16_t t = std::min(y, other.y);
+        int16_t r = std::max(right(), other.right());
+        int16_t b = std::max(bottom(), other.bottom());
+        return Rect{l, t, static_cast<int16_t>(r - l), static_cast<int16_t>(b - t)};
+    }
+
+    /**
+     * @brief 计算两个矩形的交集
+     */
+    Rect intersected(const Rect& other) const {
+        int16_t l = std::max(x, other.x);
+        int16_t t = std::max(y, other.y);
+        int16_t r = std::min(right(), other.right());
+        int16_t b = std::min(bottom(), other.bottom());
+        if (r <= l || b <= t) {
+            return Rect{};
+        }
+        return Rect{l, t, static_cast<int16_t>(r - l), static_cast<int16_t>(b - t)};
+    }
+
+    bool operator==(const Rect& other) const {
+        return x == other.x && y == other.y && w == other.w && h == other.h;
+    }
+
+    bool operator!=(const Rect& other) const { return !(*this == other); }
+};
\ No newline at end of file
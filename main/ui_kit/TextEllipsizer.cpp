@@ -0,0 +1,164 @@
+#include "TextEllipsizer.h"
+#include "TextMetricsCache.h"
+#include "esp_log.h"
+#include <cstring>
+
+static const char* TAG = "TextEllipsizer";
+
+static const char* ELLIPSIS = "...";
+
+TextEllipsizer& TextEllipsizer::getInstance() {
+    static TextEllipsizer instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+TextEllipsizer::TextEllipsizer() {
+    clear();
+}
+
+void TextEllipsizer::clear() {
+    for (size_t i = 0; i < MAX_ENTRIES; i++) {
+        _entries[i].font = nullptr;
+    }
+    for (size_t i = 0; i < GLYPH_ENTRIES; i++) {
+        _glyphs[i].font = nullptr;
+    }
+}
+
+size_t TextEllipsizer::sequenceLength(const char* p) {
+    uint8_t lead = static_cast<uint8_t>(p[0]);
+    size_t length;
+    if (lead < 0x80) {
+        return 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+    } else {
+        return 1;
+    }
+    // 续字节必须是10xxxxxx，遇到字符串结尾或非法续字节时退化为单字节
+    for (size_t i = 1; i < length; i++) {
+        if ((static_cast<uint8_t>(p[i]) & 0xC0) != 0x80) {
+            return 1;
+        }
+    }
+    return length;
+}
+
+uint32_t TextEllipsizer::decode(const char* p, size_t length) {
+    uint8_t lead = static_cast<uint8_t>(p[0]);
+    if (length == 1) {
+        return lead;
+    }
+    // 去掉首字节的长度标记位，再依次拼接续字节的低6位
+    uint32_t codePoint = lead & (0x7F >> length);
+    for (size_t i = 1; i < length; i++) {
+        codePoint = (codePoint << 6) | (static_cast<uint8_t>(p[i]) & 0x3F);
+    }
+    return codePoint;
+}
+
+int16_t TextEllipsizer::glyphWidth(DrawSurface& display, const void* font, uint16_t sizeKey,
+                                   const char* p, size_t length) {
+    uint32_t codePoint = decode(p, length);
+    Glyph& glyph = _glyphs[(codePoint ^ (static_cast<uint32_t>(sizeKey) * 31u)) % GLYPH_ENTRIES];
+    if (glyph.font == font && glyph.codePoint == codePoint && glyph.sizeKey == sizeKey) {
+        return glyph.width;
+    }
+
+    char text[5];
+    memcpy(text, p, length);
+    text[length] = '\0';
+    glyph.font = font;
+    glyph.codePoint = codePoint;
+    glyph.sizeKey = sizeKey;
+    glyph.width = static_cast<int16_t>(display.textWidth(text));
+    return glyph.width;
+}
+
+TextEllipsizer::Result TextEllipsizer::compute(DrawSurface& display, const void* font, uint16_t sizeKey,
+                                               const char* text, int16_t maxWidth) {
+    Result result;
+
+    // 省略号是完整的标签，走共享的字符串宽度缓存；逐个字形的宽度只放在字形宽度表中
+    int16_t ellipsisWidth = TextMetricsCache::getInstance().textWidth(display, ELLIPSIS);
+    int32_t advance = 0;     // 已累加的前缀宽度
+    size_t fitLength = 0;    // 加上省略号后仍能放下的最长前缀
+
+    const char* p = text;
+    while (*p) {
+        size_t length = sequenceLength(p);
+        advance += glyphWidth(display, font, sizeKey, p, length);
+        if (advance > maxWidth) {
+            // 整段文本放不下，使用最后一个能容纳省略号的前缀
+            result.length = fitLength;
+            result.truncated = true;
+            return result;
+        }
+        p += length;
+        if (advance + ellipsisWidth <= maxWidth) {
+            fitLength = p - text;
+        }
+    }
+
+    result.length = p - text;
+    result.truncated = false;
+    return result;
+}
+
+TextEllipsizer::Result TextEllipsizer::ellipsize(DrawSurface& display, const char* text, int16_t maxWidth) {
+    Result result;
+    if (text == nullptr || text[0] == '\0') {
+        return result;
+    }
+    if (maxWidth <= 0) {
+        result.truncated = true;
+        return result;
+    }
+
+    // FNV-1a 哈希
+    uint32_t hash = 2166136261u;
+    size_t length = 0;
+    for (const char* p = text; *p; p++, length++) {
+        hash ^= static_cast<uint8_t>(*p);
+        hash *= 16777619u;
+    }
+
+    const void* font = display.getFont();
+    uint16_t sizeKey = static_cast<uint16_t>(display.getTextSizeX() * 64);
+
+    Entry& entry = _entries[(hash ^ static_cast<uint32_t>(maxWidth)) % MAX_ENTRIES];
+    if (entry.font == font && entry.hash == hash && entry.length == static_cast<uint16_t>(length) &&
+        entry.sizeKey == sizeKey && entry.maxWidth == maxWidth) {
+        result.length = entry.cut;
+        result.truncated = entry.truncated;
+        return result;
+    }
+
+    result = compute(display, font, sizeKey, text, maxWidth);
+
+    entry.font = font;
+    entry.hash = hash;
+    entry.length = static_cast<uint16_t>(length);
+    entry.sizeKey = sizeKey;
+    entry.maxWidth = maxWidth;
+    entry.cut = static_cast<uint16_t>(result.length);
+    entry.truncated = result.truncated;
+
+    ESP_LOGV(TAG, "\"%s\" max %d -> %u bytes%s", text, maxWidth, (unsigned)result.length,
+             result.truncated ? " + ellipsis" : "");
+    return result;
+}
+
+void TextEllipsizer::print(DrawSurface& display, const char* text, int16_t maxWidth) {
+    Result result = ellipsize(display, text, maxWidth);
+    if (result.length > 0) {
+        display.write(reinterpret_cast<const uint8_t*>(text), result.length);
+    }
+    if (result.truncated) {
+        display.print(ELLIPSIS);
+    }
+}
\ No newline at end of file
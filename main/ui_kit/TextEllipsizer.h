@@ -0,0 +1,128 @@
+#pragma once
+
+#include "DrawSurface.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief 文本省略处理器 - 所有UI控件共享
+ * 
+ * 按UTF-8码点逐个累加字形宽度，一次遍历找到截断位置，
+ * 截断点总是落在完整字符边界上（不会切断中文等多字节字符）。
+ * 单个字形的宽度按(字体, 文字大小, 码点)保存在自己的字形宽度表中，
+ * 不占用TextMetricsCache里整段标签的宽度缓存。
+ * 处理过程中不申请堆内存，结果按(文本, 字体, 文字大小, 最大宽度)缓存。
+ */
+class TextEllipsizer {
+public:
+    static const size_t MAX_ENTRIES = 64;     ///< 结果缓存条目数（直接映射）
+    static const size_t GLYPH_ENTRIES = 256;  ///< 字形宽度表条目数（直接映射，约3KB）
+
+    /**
+     * @brief 省略处理结果
+     */
+    struct Result {
+        size_t length = 0;       ///< 需要绘制的前缀字节数
+        bool truncated = false;  ///< 是否需要在前缀后追加省略号
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return TextEllipsizer单例实例引用
+     */
+    static TextEllipsizer& getInstance();
+
+    /**
+     * @brief 计算文本在最大宽度内的截断位置（使用显示对象当前的字体和文字大小）
+     * @param display 显示对象
+     * @param text 文本内容
+     * @param maxWidth 最大宽度（像素）
+     * @return 省略处理结果
+     */
+    Result ellipsize(DrawSurface& display, const char* text, int16_t maxWidth);
+
+    /**
+     * @brief 在当前光标位置绘制省略处理后的文本
+     * @param display 显示对象
+     * @param text 文本内容
+     * @param maxWidth 最大宽度（像素）
+     */
+    void print(DrawSurface& display, const char* text, int16_t maxWidth);
+
+    /**
+     * @brief 在当前光标位置绘制省略处理后的文本
+     * @param display 显示对象
+     * @param text 文本内容
+     * @param maxWidth 最大宽度（像素）
+     */
+    void print(DrawSurface& display, const std::string& text, int16_t maxWidth) { print(display, text.c_str(), maxWidth); }
+
+    /**
+     * @brief 清空结果缓存和字形宽度表（例如更换字库后）
+     */
+    void clear();
+
+private:
+    /**
+     * @brief 结果缓存条目
+     */
+    struct Entry {
+        const void* font;   ///< 字体指针（为空表示未使用）
+        uint32_t hash;      ///< 文本哈希
+        uint16_t length;    ///< 文本长度
+        uint16_t sizeKey;   ///< 文字大小（定点数）
+        int16_t maxWidth;   ///< 最大宽度
+        uint16_t cut;       ///< 截断位置（字节）
+        bool truncated;     ///< 是否截断
+    };
+
+    /**
+     * @brief 字形宽度表条目
+     */
+    struct Glyph {
+        const void* font;    ///< 字体指针（为空表示未使用）
+        uint32_t codePoint;  ///< 码点
+        uint16_t sizeKey;    ///< 文字大小（定点数）
+        int16_t width;       ///< 字形宽度
+    };
+
+    TextEllipsizer();
+    ~TextEllipsizer() = default;
+    TextEllipsizer(const TextEllipsizer&) = delete;
+    TextEllipsizer& operator=(const TextEllipsizer&) = delete;
+
+    /**
+     * @brief 获取一个UTF-8序列的字节数
+     * @param p 序列起始位置
+     * @return 字节数（非法或不完整的序列按1字节处理）
+     */
+    static size_t sequenceLength(const char* p);
+
+    /**
+     * @brief 解码一个UTF-8序列
+     * @param p 序列起始位置
+     * @param length 序列字节数（由sequenceLength得到）
+     * @return 码点
+     */
+    static uint32_t decode(const char* p, size_t length);
+
+    /**
+     * @brief 获取单个字形的宽度，未命中时测量并记入字形宽度表
+     * @param display 显示对象
+     * @param font 当前字体
+     * @param sizeKey 当前文字大小（定点数）
+     * @param p 字形的UTF-8序列
+     * @param length 序列字节数
+     * @return 字形宽度（像素）
+     */
+    int16_t glyphWidth(DrawSurface& display, const void* font, uint16_t sizeKey, const char* p, size_t length);
+
+    /**
+     * @brief 逐码点测量计算截断位置
+     */
+    Result compute(DrawSurface& display, const void* font, uint16_t sizeKey, const char* text, int16_t maxWidth);
+
+    Entry _entries[MAX_ENTRIES];    ///< 结果缓存
+    Glyph _glyphs[GLYPH_ENTRIES];   ///< 字形宽度表
+};
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "TextMetricsCache.h"
+#include "esp_log.h"
+
+static const char* TAG = "TextMetricsCache";
+
+TextMetricsCache& TextMetricsCache::getInstance() {
+    static TextMetricsCache instance;  // C++11标准保证线程安全
+    return instance;
+}
+
+TextMetricsCache::TextMetricsCache() {
+    clear();
+}
+
+void TextMetricsCache::clear() {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        _buckets[i] = INVALID_INDEX;
+    }
+    _lruHead = INVALID_INDEX;
+    _lruTail = INVALID_INDEX;
+    _count = 0;
+    _stats.entries = 0;
+}
+
+TextMetricsCache::Stats TextMetricsCache::getStats() const {
+    return _stats;
+}
+
+void TextMetricsCache::resetStats() {
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
+}
+
+void TextMetricsCache::unlinkLru(uint16_t index) {
+    Entry& entry = _entries[index];
+    if (entry.prev != INVALID_INDEX) {
+        _entries[entry.prev].next = entry.next;
+    } else {
+        _lruHead = entry.next;
+    }
+    if (entry.next != INVALID_INDEX) {
+        _entries[entry.next].prev = entry.prev;
+    } else {
+        _lruTail = entry.prev;
+    }
+}
+
+void TextMetricsCache::pushFront(uint16_t index) {
+    Entry& entry = _entries[index];
+    entry.prev = INVALID_INDEX;
+    entry.next = _lruHead;
+    if (_lruHead != INVALID_INDEX) {
+        _entries[_lruHead].prev = index;
+    }
+    _lruHead = index;
+    if (_lruTail == INVALID_INDEX) {
+        _lruTail = index;
+    }
+}
+
+void TextMetricsCache::removeFromBucket(uint16_t index) {
+    uint16_t* link = &_buckets[_entries[index].hash % BUCKET_COUNT];
+    while (*link != INVALID_INDEX) {
+        if (*link == index) {
+            *link = _entries[index].chain;
+            return;
+        }
+        link = &_entries[*link].chain;
+    }
+}
+
+uint16_t TextMetricsCache::allocateEntry() {
+    if (_count < MAX_ENTRIES) {
+        return static_cast<uint16_t>(_count++);
+    }
+    // 缓存已满，淘汰最久未使用的条目
+    uint16_t victim = _lruTail;
+    unlinkLru(victim);
+    removeFromBucket(victim);
+    _stats.evictions++;
+    return victim;
+}
+
+int16_t TextMetricsCache::textWidth(DrawSurface& display, const char* text) {
+    if (text == nullptr || text[0] == '\0') {
+        return 0;
+    }
+
+    // FNV-1a 哈希
+    uint32_t hash = 2166136261u;
+    size_t length = 0;
+    for (const char* p = text; *p; p++, length++) {
+        hash ^= static_cast<uint8_t>(*p);
+        hash *= 16777619u;
+    }
+
+    const void* font = display.getFont();
+    uint16_t sizeKey = static_cast<uint16_t>(display.getTextSizeX() * 64);
+
+    for (uint16_t index = _buckets[hash % BUCKET_COUNT]; index != INVALID_INDEX; index = _entries[index].chain) {
+        Entry& entry = _entries[index];
+        if (entry.hash == hash && entry.font == font && entry.sizeKey == sizeKey &&
+            entry.length == static_cast<uint16_t>(length)) {
+            _stats.hits++;
+            if (_lruHead != index) {
+                unlinkLru(index);
+                pushFront(index);
+            }
+            return entry.width;
+        }
+    }
+
+    _stats.misses++;
+    int16_t width = display.textWidth(text);
+
+    uint16_t index = allocateEntry();
+    Entry& entry = _entries[index];
+    entry.font = font;
+    entry.hash = hash;
+    entry.length = static_cast<uint16_t>(length);
+    entry.sizeKey = sizeKey;
+    entry.width = width;
+    uint16_t& bucket = _buckets[hash % BUCKET_COUNT];
+    entry.chain = bucket;
+    bucket = index;
+    pushFront(index);
+    _stats.entries = _count;
+
+    ESP_LOGV(TAG, "miss: \"%s\" -> %d", text, width);
+    return width;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "DrawSurface.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief 文本宽度缓存 - 所有UI控件共享
+ * 
+ * 以(字体, 文字大小, 字符串哈希)为键缓存textWidth的结果，
+ * 使用固定容量的LRU淘汰，不会在运行期间额外申请内存。
+ * 中文字符串在efont字库中逐字查找字形很慢，相同的标签会被反复测量。
+ */
+class TextMetricsCache {
+public:
+    static const size_t MAX_ENTRIES = 256;   ///< 最大缓存条目数（约5KB）
+    static const size_t BUCKET_COUNT = 128;  ///< 哈希桶数量
+
+    /**
+     * @brief 缓存统计信息
+     */
+    struct Stats {
+        uint32_t hits = 0;       ///< 命中次数
+        uint32_t misses = 0;     ///< 未命中次数
+        uint32_t evictions = 0;  ///< 淘汰次数
+        size_t entries = 0;      ///< 当前条目数
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return TextMetricsCache单例实例引用
+     */
+    static TextMetricsCache& getInstance();
+
+    /**
+     * @brief 获取文本宽度（使用显示对象当前的字体和文字大小）
+     * @param display 显示对象
+     * @param text 文本内容
+     * @return 文本宽度（像素）
+     */
+    int16_t textWidth(DrawSurface& display, const char* text);
+
+    /**
+     * @brief 获取文本宽度（使用显示对象当前的字体和文字大小）
+     * @param display 显示对象
+     * @param text 文本内容
+     * @return 文本宽度（像素）
+     */
+    int16_t textWidth(DrawSurface& display, const std::string& text) { return textWidth(display, text.c_str()); }
+
+    /**
+     * @brief 清空缓存（例如更换字库后）
+     */
+    void clear();
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计信息
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief 重置命中/未命中计数
+     */
+    void resetStats();
+
+private:
+    static const uint16_t INVALID_INDEX = 0xFFFF;
+
+    /**
+     * @brief 缓存条目
+     */
+    struct Entry {
+        const void* font;     ///< 字体指针
+        uint32_t hash;        ///< 字符串哈希
+        uint16_t length;      ///< 字符串长度（降低哈希冲突的概率）
+        uint16_t sizeKey;     ///< 文字大小（定点数）
+        int16_t width;        ///< 测量得到的宽度
+        uint16_t prev;        ///< LRU链表前驱
+        uint16_t next;        ///< LRU链表后继
+        uint16_t chain;       ///< 同一哈希桶中的下一个条目
+    };
+
+    TextMetricsCache();
+    ~TextMetricsCache() = default;
+    TextMetricsCache(const TextMetricsCache&) = delete;
+    TextMetricsCache& operator=(const TextMetricsCache&) = delete;
+
+    void unlinkLru(uint16_t index);
+    void pushFront(uint16_t index);
+    void removeFromBucket(uint16_t index);
+    uint16_t allocateEntry();
+
+    Entry _entries[MAX_ENTRIES];        ///< 条目存储
+    uint16_t _buckets[BUCKET_COUNT];    ///< 哈希桶链表头
+    uint16_t _lruHead = INVALID_INDEX;  ///< 最近使用的条目
+    uint16_t _lruTail = INVALID_INDEX;  ///< 最久未使用的条目
+    size_t _count = 0;                  ///< 已使用的条目数
+    Stats _stats;                       ///< 统计信息
+};
\ No newline at end of file
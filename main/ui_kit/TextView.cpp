@@ -1,7 +1,8 @@
 #include "TextView.h"
+#include "TextMetricsCache.h"
 
 TextView::TextView(int16_t width, int16_t height)
-    : View(width, height), _text(""), _textColor(TFT_BLACK), _textSize(1), _textAlign(0) {
+    : View(width, height), _text(""), _textColor(TFT_BLACK), _textSize(1.0f), _textAlign(0) {
 }
 
 void TextView::setText(const std::string& text) {
@@ -22,7 +23,7 @@ void TextView::setTextColor(uint32_t color) {
     }
 }
 
-void TextView::setTextSize(uint8_t size) {
+void TextView::setTextSize(float size) {
     if (_textSize != size) {
         _textSize = size;
         markDirty();  // 字体大小变化时标记为需要重绘
@@ -36,15 +37,12 @@ void TextView::setTextAlign(uint8_t align) {
     }
 }
 
-void TextView::draw(m5gfx::M5GFX& display) {
-    if (_visibility == GONE) {
-        return;
-    }
-
+void TextView::onDraw(DrawSurface& display) {
+    TextMetricsCache& metrics = TextMetricsCache::getInstance();
     // 绘制背景
-    View::draw(display);
+    View::onDraw(display);
 
-    if (_visibility == VISIBLE && !_text.empty()) {
+    if (!_text.empty()) {
         display.setTextColor(_textColor);
         display.setTextSize(_textSize);
         
@@ -54,7 +52,7 @@ void TextView::draw(m5gfx::M5GFX& display) {
         int16_t contentWidth = _width - _paddingLeft - _paddingRight;
         int16_t contentHeight = _height - _paddingTop - _paddingBottom;
         
-        int16_t textWidth = display.textWidth(_text.c_str());
+        int16_t textWidth = metrics.textWidth(display, _text.c_str());
         int16_t drawX = contentX;
         
         // 根据对齐方式计算文本绘制位置（在内容区域内）
@@ -77,15 +75,15 @@ void TextView::draw(m5gfx::M5GFX& display) {
     }
 }
 
-void TextView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void TextView::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 如果宽度或高度未设置，可以根据文本内容计算
     if (_width <= 0) {
         if (widthMeasureSpec > 0) {
             _width = widthMeasureSpec;
         } else {
-            // 根据文本内容估算宽度
-            m5gfx::M5GFX tempDisplay; // 创建临时显示对象以获取字体信息
-            _width = tempDisplay.textWidth(_text.c_str()) + 10; // 添加一些padding
+            // 在视图所绘制的表面上按自身的文字大小测量（绘制前会重新设置文字大小）
+            surface.setTextSize(_textSize);
+            _width = TextMetricsCache::getInstance().textWidth(surface, _text) + 10; // 添加一些padding
         }
     }
     
@@ -94,8 +92,8 @@ void TextView::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
             _height = heightMeasureSpec;
         } else {
             // 根据字体大小估算高度
-            m5gfx::M5GFX tempDisplay; // 创建临时显示对象以获取字体信息
-            _height = tempDisplay.fontHeight() + 10; // 添加一些padding
+            surface.setTextSize(_textSize);
+            _height = surface.fontHeight() + 10; // 添加一些padding
         }
     }
 }
\ No newline at end of file
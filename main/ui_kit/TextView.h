@@ -37,9 +37,9 @@ public:
 
     /**
      * @brief 设置文本大小
-     * @param size 文本大小
+     * @param size 文本大小（缩放倍数，可以是1.5这样的小数，与绘制列表项时的文字大小一致）
      */
-    void setTextSize(uint8_t size);
+    void setTextSize(float size);
 
     /**
      * @brief 设置文本对齐方式
@@ -48,27 +48,29 @@ public:
     void setTextAlign(uint8_t align);
 
     /**
-     * @brief 重写绘制方法
-     * @param display 显示对象
+     * @brief 获取类名
+     * @return 类名字符串
      */
-    virtual void draw(m5gfx::M5GFX& display) override;
+    virtual std::string className() const override { return "TextView"; }
 
+protected:
     /**
      * @brief 重写测量方法
+     * @param surface 视图所在的绘制表面（用于测量文字）
      * @param widthMeasureSpec 父容器提供的宽度约束
      * @param heightMeasureSpec 父容器提供的高度约束
      */
-    virtual void measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+    virtual void onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
 
     /**
-     * @brief 获取类名
-     * @return 类名字符串
+     * @brief 绘制背景和文本内容
+     * @param display 显示对象
      */
-    virtual std::string className() const override { return "TextView"; }
+    virtual void onDraw(DrawSurface& display) override;
 
 private:
     std::string _text;        ///< 文本内容
     uint32_t _textColor = TFT_BLACK;      ///< 文本颜色
-    uint8_t _textSize;        ///< 文本大小
+    float _textSize;          ///< 文本大小（缩放倍数）
     uint8_t _textAlign;       ///< 文本对齐方式
 };
\ No newline at end of file
@@ -1,6 +1,12 @@
 #pragma once
 
 // UI Kit 主头文件 - 包含所有UI组件
+#include "Rect.h"
+#include "DrawSurface.h"
+#include "DirtyRegion.h"
+#include "TextMetricsCache.h"
+#include "TextEllipsizer.h"
+#include "InlineFunction.h"
 #include "View.h"
 #include "ViewGroup.h"
 #include "TextView.h"
@@ -8,6 +14,7 @@
 #include "LinearLayout.h"
 #include "FrameLayout.h"
 #include "ListView.h"
+#include "ListAdapter.h"
 #include "PagedListView.h"
 #include "Dialog.h"
 #include "QRCodeView.h"
@@ -1,4 +1,5 @@
 #include "View.h"
+#include "DirtyRegion.h"
 #include "esp_log.h"
 
 View::View(int16_t width, int16_t height)
@@ -7,20 +8,48 @@ View::View(int16_t width, int16_t height)
 }
 
 View::~View() {
+    // 从父视图的子树脏计数中移除自身的贡献
+    setParent(nullptr);
 }
 
 void View::setPosition(int16_t left, int16_t top) {
+    if (_left == left && _top == top) {
+        return;
+    }
+    Rect oldBounds = getBounds();
     _left = left;
     _top = top;
+    onBoundsChanged(oldBounds);
+    requestLayout();
 }
 
 void View::setSize(int16_t width, int16_t height) {
+    if (_width == width && _height == height) {
+        return;
+    }
+    Rect oldBounds = getBounds();
     _width = width;
     _height = height;
+    onBoundsChanged(oldBounds);
+    requestLayout();
 }
 
 void View::setVisibility(Visibility visibility) {
+    if (_visibility == visibility) {
+        return;
+    }
+    bool layoutChanged = (_visibility == GONE || visibility == GONE);
     _visibility = visibility;
+    if (_parent && _parent != this && visibility != VISIBLE) {
+        // 隐藏后由父视图重绘背景来擦除原来的内容
+        _parent->markDirty();
+    } else {
+        markDirty();
+    }
+    // 与GONE之间切换会影响兄弟视图的位置，需要重新布局
+    if (layoutChanged) {
+        requestLayout();
+    }
 }
 
 
@@ -38,28 +67,27 @@ void View::setPadding(uint8_t left, uint8_t top, uint8_t right, uint8_t bottom)
     _paddingTop = top;
     _paddingRight = right;
     _paddingBottom = bottom;
-    markDirty();  // 内边距改变需要重绘
+    requestLayout();  // 内边距改变需要重新布局
 }
 
 bool View::contains(int16_t x, int16_t y) const {
     return x >= _left && x < (_left + _width) && y >= _top && y < (_top + _height);
 }
 
-void View::draw(m5gfx::M5GFX& display) {
+void View::draw(DrawSurface& display) {
     if (_visibility == GONE) {
         return;
     }
 
     if (_visibility == VISIBLE && _isDirty) {
         onDraw(display);
-        
-        // 标记为已绘制，清除脏标记
-        _isDirty = false;
         _lastDrawTime = esp_log_timestamp();
     }
+    // 标记为已绘制，清除脏标记（不可见的视图也要清除，否则父视图会一直处于脏状态）
+    setDirtyFlag(false);
 }
 
-void View::onDraw(m5gfx::M5GFX& display) {
+void View::onDraw(DrawSurface& display) {
     ESP_LOGV("View", "className: %s onDraw called", className().c_str());
     // 绘制背景（考虑边框宽度）
     int borderWidthOffset = _borderWidth > 0 ? _borderWidth : 0;
@@ -79,7 +107,19 @@ void View::onDraw(m5gfx::M5GFX& display) {
     }
 }
 
-void View::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void View::measure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+    // 约束未变化且没有几何变化时复用上次的测量结果
+    if (_hasMeasured && !_layoutRequested &&
+        widthMeasureSpec == _lastWidthSpec && heightMeasureSpec == _lastHeightSpec) {
+        return;
+    }
+    onMeasure(surface, widthMeasureSpec, heightMeasureSpec);
+    _lastWidthSpec = widthMeasureSpec;
+    _lastHeightSpec = heightMeasureSpec;
+    _hasMeasured = true;
+}
+
+void View::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 子类可以重写此方法以自定义测量逻辑
     // 默认情况下，使用设定的尺寸或父容器的限制
     if (_width <= 0 && widthMeasureSpec > 0) {
@@ -91,12 +131,32 @@ void View::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
 }
 
 void View::layout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
-    _left = left;
-    _top = top;
-    _width = right - left;
-    _height = bottom - top;
-    
-    onLayout(left, top, right, bottom);
+    Rect oldBounds = getBounds();
+    Rect newBounds{left, top, static_cast<int16_t>(right - left), static_cast<int16_t>(bottom - top)};
+    bool changed = newBounds != oldBounds;
+    if (changed) {
+        _left = left;
+        _top = top;
+        _width = newBounds.w;
+        _height = newBounds.h;
+        onBoundsChanged(oldBounds);
+    }
+
+    // 边界未变化且没有请求布局时，子视图的位置也不会变化，无需重新布局
+    if (changed || _layoutRequested) {
+        _layoutRequested = false;
+        onLayout(left, top, right, bottom);
+    }
+}
+
+void View::onBoundsChanged(const Rect& oldBounds) {
+    // 旧区域和新区域都需要更新到屏幕
+    invalidateRect(oldBounds);
+    markDirty();
+    // 由父视图重绘背景来擦除旧区域中露出的部分
+    if (_parent && _parent != this) {
+        _parent->markDirty();
+    }
 }
 
 void View::onLayout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
@@ -115,27 +175,71 @@ bool View::onTouch(int16_t x, int16_t y) {
     return false;
 }
 
-bool View::onSwipe(TouchGestureDetector::SwipeDirection direction) {
+bool View::onSwipe(TouchGestureDetector::SwipeDirection direction, int count) {
     // 默认实现：不处理滑动事件
     return false;
 }
 
-void View::setOnClickListener(std::function<void()> callback) {
-    _clickCallback = callback;
+void View::setOnClickListener(InlineFunction<void()> callback) {
+    _clickCallback = std::move(callback);
 }
 
 void View::markDirty() {
-    _isDirty = true;
-    // 通知父视图需要重绘
+    setDirtyFlag(true);
+    // 将自身区域记录为脏区域，经由父视图上报到根视图
+    invalidateRect(getBounds());
+}
+
+void View::requestLayout() {
+    _layoutRequested = true;
+    markDirty();
+    // 祖先视图只需要重新布局，是否重绘由布局结果（边界是否变化）决定
+    for (View* ancestor = _parent; ancestor != nullptr && ancestor != this; ancestor = ancestor->_parent) {
+        ancestor->_layoutRequested = true;
+    }
+}
+
+void View::invalidateRect(const Rect& rect) {
     if (_parent && _parent != this) {
-        notifyParentOfChange();
+        _parent->invalidateRect(rect);
+    }
+}
+
+void View::takeDirtyRegion(DirtyRegion& region) {
+    // 普通视图不汇总脏区域，由根视图组负责
+}
+
+void View::setDirtyFlag(bool dirty) {
+    if (_isDirty == dirty) {
+        return;
     }
+    _isDirty = dirty;
+    // 只在状态变化时向上传播一次，查询时不需要遍历子树
+    adjustAncestorDirtyCount(dirty ? 1 : -1);
+}
+
+void View::adjustAncestorDirtyCount(int32_t delta) {
+    if (delta == 0) {
+        return;
+    }
+    for (View* ancestor = _parent; ancestor != nullptr && ancestor != this; ancestor = ancestor->_parent) {
+        ancestor->_dirtyDescendants += delta;
+    }
+}
+
+void View::setParent(View* parent) {
+    if (_parent == parent) {
+        return;
+    }
+    // 将整个子树的脏计数从旧的祖先链转移到新的祖先链
+    int32_t subtreeDirty = _dirtyDescendants + (_isDirty ? 1 : 0);
+    adjustAncestorDirtyCount(-subtreeDirty);
+    _parent = parent;
+    adjustAncestorDirtyCount(subtreeDirty);
 }
 
 void View::forceRedraw() {
-    _isDirty = true;
-    // 通知父视图需要重绘
-    notifyParentOfChange();
+    markDirty();
 }
 
 
@@ -143,8 +247,9 @@ void View::forceRedraw() {
 void View::notifyParentOfChange() {
     // 通知父视图需要重绘
     // 确保_parent不为空且不等于自身以防止基本的循环引用
+    // 只上报自身的损坏区域，父视图不需要重绘背景，
+    // 父视图的isDirty()会通过子视图的脏标记得知需要遍历绘制
     if (_parent && _parent != this) {
-        _parent->markDirty();
-        _parent->notifyParentOfChange();  // 继续向上通知
+        _parent->invalidateRect(getBounds());
     }
 }
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
-#include "M5Unified.h"
 #include <cstdint>
-#include <functional>
+#include <string>
+#include "InlineFunction.h"
 #include "../gestures/TouchGestureDetector.h"
+#include "Rect.h"
+#include "DrawSurface.h"
+#include "ViewArena.h"
 
 // 前向声明
 class ViewGroup;
+class DirtyRegion;
 
 /**
  * @brief View基类 - 所有UI控件的基础
@@ -30,6 +34,12 @@ public:
 
     virtual ~View();
 
+    /**
+     * @brief 视图对象的内存来自当前页面的视图内存池（没有时来自堆），见ViewArena
+     */
+    static void* operator new(size_t size) { return ViewArena::allocateView(size); }
+    static void operator delete(void* ptr) { ViewArena::freeView(ptr); }
+
     /**
      * @brief 获取视图的左侧位置
      * @return 左侧位置
@@ -54,6 +64,12 @@ public:
      */
     int16_t getHeight() const { return _height; }
 
+    /**
+     * @brief 获取视图的边界矩形
+     * @return 边界矩形
+     */
+    Rect getBounds() const { return Rect{_left, _top, _width, _height}; }
+
     /**
      * @brief 设置视图的位置
      * @param left 左侧位置
@@ -137,14 +153,17 @@ public:
      * @brief 绘制视图
      * @param display 显示对象
      */
-    virtual void draw(m5gfx::M5GFX& display);
+    virtual void draw(DrawSurface& display);
 
     /**
      * @brief 测量视图所需的空间
+     * 
+     * 约束与上次相同且没有请求重新布局时直接使用上次的测量结果
+     * @param surface 视图所在的绘制表面（用于测量文字）
      * @param widthMeasureSpec 父容器提供的宽度约束
      * @param heightMeasureSpec 父容器提供的高度约束
      */
-    virtual void measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec);
+    void measure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec);
 
     /**
      * @brief 布局视图
@@ -166,27 +185,72 @@ public:
     /**
      * @brief 处理滑动事件
      * @param direction 滑动方向
+     * @param count 连续同向滑动的次数（刷新期间的滑动会被合并）
      * @return 如果处理了事件返回true，否则返回false
      */
-    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction);
+    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction, int count = 1);
 
     /**
      * @brief 设置点击回调函数
      * @param callback 回调函数
      */
-    void setOnClickListener(std::function<void()> callback);
+    void setOnClickListener(InlineFunction<void()> callback);
 
     /**
-     * @brief 检查视图是否需要重绘
+     * @brief 检查视图或其子树是否需要重绘
+     * 
+     * 通过维护的子树脏计数实现常数时间查询，不需要遍历子视图
      * @return 如果需要重绘返回true，否则返回false
      */
-    virtual bool isDirty() const { return _isDirty; }
+    virtual bool isDirty() const { return _isDirty || _dirtyDescendants > 0; }
 
     /**
-     * @brief 标记视图为需要重绘
+     * @brief 标记视图为需要重绘，并将视图边界记录为脏区域
+     * 
+     * 仅用于内容变化（文本、颜色等），不会触发重新测量和布局
      */
     void markDirty();
 
+    /**
+     * @brief 请求重新测量和布局
+     * 
+     * 用于几何变化（尺寸、内边距、间距、子视图增删、GONE状态切换），
+     * 请求会传递到根视图，在下一次绘制前统一执行一次测量和布局
+     */
+    void requestLayout();
+
+    /**
+     * @brief 检查是否请求了重新布局
+     * @return 如果需要重新测量和布局返回true
+     */
+    bool isLayoutRequested() const { return _layoutRequested; }
+
+    /**
+     * @brief 记录需要推送到屏幕的损坏区域
+     * 
+     * 默认实现将区域向上传递给父视图，最终由根视图组汇总
+     * @param rect 损坏区域
+     */
+    virtual void invalidateRect(const Rect& rect);
+
+    /**
+     * @brief 取出并清空累积的脏区域（仅对根视图组有效）
+     * @param region 输出的脏区域
+     */
+    virtual void takeDirtyRegion(DirtyRegion& region);
+
+    /**
+     * @brief 父视图重绘了背景，标记自身需要随之重绘
+     * 
+     * 不记录脏区域，也不通知父视图（父视图的区域已经被记录）
+     */
+    void onParentRedraw() { setDirtyFlag(true); }
+
+    /**
+     * @brief 丢弃自身的脏标记（不可见的视图不需要绘制）
+     */
+    virtual void clearDirty() { setDirtyFlag(false); }
+
     /**
      * @brief 获取最后绘制时间
      * @return 最后绘制时间戳
@@ -204,7 +268,7 @@ public:
      * @brief 设置父视图
      * @param parent 父视图指针
      */
-    void setParent(View* parent) { _parent = parent; }
+    void setParent(View* parent);
 
     /**
      * @brief 强制标记整个视图树为需要重绘
@@ -215,11 +279,19 @@ public:
 
 protected:
 
+    /**
+     * @brief 实际执行测量操作的内部方法
+     * @param surface 视图所在的绘制表面（用于测量文字）
+     * @param widthMeasureSpec 父容器提供的宽度约束
+     * @param heightMeasureSpec 父容器提供的高度约束
+     */
+    virtual void onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec);
+
     /**
      * @brief 实际执行绘制操作的内部方法
      * @param display 显示对象
      */
-    virtual void onDraw(m5gfx::M5GFX& display);
+    virtual void onDraw(DrawSurface& display);
     /**
      * @brief 实际执行布局操作的内部方法
      * @param left 左边界
@@ -229,6 +301,26 @@ protected:
      */
     virtual void onLayout(int16_t left, int16_t top, int16_t right, int16_t bottom);
 
+    /**
+     * @brief 位置或尺寸变化后记录脏区域
+     * 
+     * 旧区域和新区域都需要推送到屏幕，父视图需要重绘背景以擦除旧区域
+     * @param oldBounds 变化前的边界
+     */
+    void onBoundsChanged(const Rect& oldBounds);
+
+    /**
+     * @brief 设置自身脏标记，并在状态变化时更新所有祖先的子树脏计数
+     * @param dirty 是否需要重绘
+     */
+    void setDirtyFlag(bool dirty);
+
+    /**
+     * @brief 调整所有祖先视图的子树脏计数
+     * @param delta 变化量
+     */
+    void adjustAncestorDirtyCount(int32_t delta);
+
     int16_t _left = 0, _top = 0;      ///< 视图的左上角位置
     int16_t _width = 0, _height = 0;  ///< 视图的宽高
     Visibility _visibility = VISIBLE;   ///< 可见性状态
@@ -239,8 +331,13 @@ protected:
     uint8_t _paddingRight = 0;    ///< 右侧内边距
     uint8_t _paddingBottom = 0;   ///< 底部内边距
     bool _isPressed = false;          ///< 是否被按下
-    std::function<void()> _clickCallback = nullptr; ///< 点击回调函数
+    InlineFunction<void()> _clickCallback = nullptr; ///< 点击回调函数
     bool _isDirty = true;            ///< 是否需要重绘
+    int32_t _dirtyDescendants = 0;   ///< 子树中需要重绘的后代视图数量
+    bool _layoutRequested = true;    ///< 是否需要重新测量和布局
+    bool _hasMeasured = false;       ///< 是否已有测量结果
+    int16_t _lastWidthSpec = 0;      ///< 上次测量的宽度约束
+    int16_t _lastHeightSpec = 0;     ///< 上次测量的高度约束
     int32_t _lastDrawTime = 0;    ///< 最后绘制时间戳
     View* _parent = nullptr;            ///< 父视图指针
 };
\ No newline at end of file
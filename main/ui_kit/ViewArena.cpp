@@ -0,0 +1,127 @@
+#include "ViewArena.h"
+#include "esp_log.h"
+#include "memory/MemoryPolicy.h"
+#include <cstdlib>
+#include <new>
+
+static const char* TAG = "ViewArena";
+
+// 分配按max_align_t对齐，视图内存前的头部也占一个对齐单位
+static const size_t ALIGNMENT = alignof(std::max_align_t);
+static const size_t VIEW_HEADER = ALIGNMENT;
+
+// 视图头部记录的来源
+static const uint32_t FROM_HEAP = 0x48454150;   // "HEAP"
+static const uint32_t FROM_ARENA = 0x4152454E;  // "AREN"
+
+static constexpr size_t alignUp(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+const size_t ViewArena::BLOCK_HEADER = alignUp(sizeof(ViewArena::Block));
+ViewArena* ViewArena::s_current = nullptr;
+
+ViewArena::Scope::Scope(ViewArena& arena) : _previous(s_current) {
+    s_current = &arena;
+}
+
+ViewArena::Scope::~Scope() {
+    s_current = _previous;
+}
+
+ViewArena::~ViewArena() {
+    release();
+}
+
+void ViewArena::reserve(size_t bytes) {
+    bytes = alignUp(bytes);
+    if (bytes == 0 || (_head != nullptr && _head->size - _head->used >= bytes)) {
+        return;
+    }
+    addBlock(bytes);
+}
+
+bool ViewArena::addBlock(size_t minSize) {
+    size_t size = minSize > DEFAULT_BLOCK_SIZE ? minSize : DEFAULT_BLOCK_SIZE;
+    // 视图在每次绘制和触摸时都会访问，放在内部RAM中
+    void* memory = MemoryPolicy::allocate(MemoryTag::UI_INTERNAL, BLOCK_HEADER + size);
+    if (memory == nullptr) {
+        ESP_LOGW(TAG, "Failed to allocate a %u byte block", (unsigned)size);
+        return false;
+    }
+    Block* block = static_cast<Block*>(memory);
+    block->next = _head;
+    block->size = size;
+    block->used = 0;
+    _head = block;
+    _capacity += size;
+    _blocks++;
+    return true;
+}
+
+void* ViewArena::allocate(size_t size) {
+    size = alignUp(size ? size : 1);
+    if (_head == nullptr || _head->size - _head->used < size) {
+        // 当前块剩余的空间放弃，单调分配不回头查找
+        if (!addBlock(size)) {
+            return nullptr;
+        }
+    }
+    uint8_t* data = reinterpret_cast<uint8_t*>(_head) + BLOCK_HEADER + _head->used;
+    _head->used += size;
+    _used += size;
+    return data;
+}
+
+void ViewArena::release() {
+    if (s_current == this) {
+        ESP_LOGW(TAG, "Releasing the active arena");
+    }
+    Block* block = _head;
+    while (block != nullptr) {
+        Block* next = block->next;
+        MemoryPolicy::release(MemoryTag::UI_INTERNAL, block, BLOCK_HEADER + block->size);
+        block = next;
+    }
+    _head = nullptr;
+    _used = 0;
+    _capacity = 0;
+    _blocks = 0;
+}
+
+ViewArena::Stats ViewArena::getStats() const {
+    Stats stats;
+    stats.used = _used;
+    stats.capacity = _capacity;
+    stats.blocks = _blocks;
+    return stats;
+}
+
+void* ViewArena::allocateView(size_t size) {
+    uint8_t* memory = nullptr;
+    uint32_t source = FROM_ARENA;
+    if (s_current != nullptr) {
+        memory = static_cast<uint8_t*>(s_current->allocate(VIEW_HEADER + size));
+    }
+    if (memory == nullptr) {
+        source = FROM_HEAP;
+        memory = static_cast<uint8_t*>(::operator new(VIEW_HEADER + size));
+    }
+    *reinterpret_cast<uint32_t*>(memory) = source;
+    return memory + VIEW_HEADER;
+}
+
+void ViewArena::freeView(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    uint8_t* memory = static_cast<uint8_t*>(ptr) - VIEW_HEADER;
+    uint32_t source = *reinterpret_cast<uint32_t*>(memory);
+    if (source == FROM_HEAP) {
+        ::operator delete(memory);
+    } else if (source != FROM_ARENA) {
+        ESP_LOGE(TAG, "Freeing a view with a corrupted header: %p", ptr);
+        abort();
+    }
+    // 内存池中的视图在内存池释放时统一回收
+}
\ No newline at end of file
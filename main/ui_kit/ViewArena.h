@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 默认不输出视图内存池的统计，需要时在main/CMakeLists.txt中定义VIEW_ARENA_DEBUG=1
+#ifndef VIEW_ARENA_DEBUG
+#define VIEW_ARENA_DEBUG 0
+#endif
+
+/**
+ * @brief ViewArena - 页面级视图内存池
+ *
+ * 页面的视图树从少数几块连续内存中单调分配，页面销毁时一次释放，
+ * 反复切换页面不会在堆上留下零散的小块。
+ *
+ * 存在活动的Scope时，View的operator new从当前内存池分配，页面代码仍然用new创建视图；
+ * delete照常执行析构函数（std::string等成员仍在堆上释放），只有视图对象本身的内存
+ * 要等内存池释放时才归还。因此页面存活期间删除的视图不会腾出空间。
+ * 只在UI任务中使用。
+ */
+class ViewArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 2048;  ///< 没有预估大小时每块的字节数
+
+    /**
+     * @brief 内存池统计信息
+     */
+    struct Stats {
+        size_t used = 0;      ///< 已分配的字节数（即高水位，内存池只增不减）
+        size_t capacity = 0;  ///< 已申请的块总字节数
+        size_t blocks = 0;    ///< 块数量
+    };
+
+    /**
+     * @brief 在作用域内把内存池设为当前内存池，可以嵌套
+     */
+    class Scope {
+    public:
+        explicit Scope(ViewArena& arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ViewArena* _previous;  ///< 进入作用域前的当前内存池
+    };
+
+    ViewArena() = default;
+    ~ViewArena();
+    ViewArena(const ViewArena&) = delete;
+    ViewArena& operator=(const ViewArena&) = delete;
+
+    /**
+     * @brief 预留容量，使接下来的分配落在一块连续内存中
+     * @param bytes 预计的总字节数（通常是同类型页面上次的高水位）
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * @brief 分配内存（按max_align_t对齐）
+     * @param size 字节数
+     * @return 内存指针，申请失败返回nullptr
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief 一次释放所有块（之前分配的对象必须已经析构）
+     */
+    void release();
+
+    /**
+     * @brief 获取统计信息
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief 获取当前内存池
+     * @return 没有活动的Scope时返回nullptr
+     */
+    static ViewArena* current() { return s_current; }
+
+    /**
+     * @brief 为视图分配内存（View::operator new调用）
+     *
+     * 有当前内存池时从内存池分配，否则从堆分配；前面保留一个头部记录来源
+     */
+    static void* allocateView(size_t size);
+
+    /**
+     * @brief 释放视图内存（View::operator delete调用），内存池中的视图等内存池释放时回收
+     */
+    static void freeView(void* ptr);
+
+private:
+    /**
+     * @brief 内存块，数据紧跟在块头之后
+     */
+    struct Block {
+        Block* next;   ///< 下一块
+        size_t size;   ///< 数据区字节数
+        size_t used;   ///< 已用字节数
+    };
+
+    /**
+     * @brief 申请新块
+     * @param minSize 数据区最少字节数
+     * @return 成功返回true
+     */
+    bool addBlock(size_t minSize);
+
+    static const size_t BLOCK_HEADER;  ///< 块头按max_align_t对齐后的字节数
+
+    Block* _head = nullptr;  ///< 当前分配的块（链表头）
+    size_t _used = 0;        ///< 所有块已用字节数
+    size_t _capacity = 0;    ///< 所有块数据区字节数
+    size_t _blocks = 0;      ///< 块数量
+
+    static ViewArena* s_current;  ///< 当前内存池
+};
\ No newline at end of file
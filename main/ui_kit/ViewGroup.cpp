@@ -2,6 +2,8 @@
 #include "View.h"
 #include <algorithm>
 
+ViewGroup::RootInvalidateHook ViewGroup::s_rootInvalidateHook = nullptr;
+
 ViewGroup::ViewGroup(int16_t width, int16_t height)
     : View(width, height) {
 }
@@ -14,8 +16,8 @@ void ViewGroup::addChild(View* child) {
     if (child != nullptr) {
         _children.push_back(child);
         child->setParent(this);  // 设置父视图引用
-        
-
+        child->markDirty();      // 新子视图的区域需要绘制
+        requestLayout();         // 子视图变化需要重新布局
     }
 }
 
@@ -24,6 +26,9 @@ void ViewGroup::removeChild(View* child) {
         auto it = std::find(_children.begin(), _children.end(), child);
         if (it != _children.end()) {
             _children.erase(it);
+            child->setParent(nullptr);
+            // 子视图原来占据的区域需要由自身背景覆盖，其余子视图需要重新布局
+            requestLayout();
             // 注意：这里不删除 child 对象，因为可能在其他地方还有引用
             // 子视图的生命周期管理留给调用者或 removeAllChildren
         }
@@ -37,6 +42,9 @@ void ViewGroup::removeAllChildren() {
             delete child;
         }
     }
+    if (!_children.empty()) {
+        requestLayout();
+    }
     _children.clear();
 }
 
@@ -51,28 +59,51 @@ View* ViewGroup::getChildAt(size_t index) const {
     return nullptr;
 }
 
-void ViewGroup::draw(m5gfx::M5GFX& display) {
+void ViewGroup::draw(DrawSurface& display) {
     if (_visibility == GONE) {
         return;
     }
 
     // 只有当自身或子视图需要重绘时才进行绘制
     if (isDirty()) {
-        // 确保视图组已正确布局
-        layout(_left, _top, _left + _width, _top + _height);
+        // 只有几何变化时才重新测量和布局，纯内容变化直接重绘
+        if (isLayoutRequested()) {
+            if (_parent == nullptr) {
+                // 根视图发起测量，子视图的测量结果有缓存
+                measure(display, _width, _height);
+            }
+            layout(_left, _top, _left + _width, _top + _height);
+        }
+
+        // 自身背景重绘会覆盖子视图，此时所有子视图都需要重绘
+        bool redrawChildren = _isDirty;
 
         // 绘制自身（背景、边框等）
         View::draw(display);
 
         // 绘制所有可见的子视图
-        for (auto child : _children) {
-            if (child->getVisibility() != GONE) {
-                child->draw(display);
-            }
-        }
+        drawChildren(display, redrawChildren);
         
         // 标记为已绘制，清除脏标记
-        _isDirty = false;
+        setDirtyFlag(false);
+    }
+}
+
+void ViewGroup::drawChildren(DrawSurface& display, bool redrawAll) {
+    Rect redrawn;  // 本次已重绘的子视图区域，与之重叠的后续子视图需要重新覆盖绘制
+    for (auto child : _children) {
+        if (child->getVisibility() == GONE) {
+            // 不参与绘制的子视图直接丢弃脏标记，避免父视图一直处于脏状态
+            child->clearDirty();
+            continue;
+        }
+        if (redrawAll || child->getBounds().intersects(redrawn)) {
+            child->onParentRedraw();
+        }
+        if (child->isDirty()) {
+            redrawn = redrawn.united(child->getBounds());
+        }
+        child->draw(display);
     }
 }
 
@@ -93,57 +124,43 @@ bool ViewGroup::onTouch(int16_t x, int16_t y) {
     return View::onTouch(x, y);
 }
 
-bool ViewGroup::onSwipe(TouchGestureDetector::SwipeDirection direction) {
+bool ViewGroup::onSwipe(TouchGestureDetector::SwipeDirection direction, int count) {
     // 首先检查子视图是否处理滑动事件
     for (auto it = _children.rbegin(); it != _children.rend(); ++it) {
         View* child = *it;
-        if (child->onSwipe(direction)) {
+        if (child->onSwipe(direction, count)) {
             return true;
         }
     }
 
     // 如果没有子视图处理，则由自己处理
-    return View::onSwipe(direction);
+    return View::onSwipe(direction, count);
 }
 
-void ViewGroup::measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
+void ViewGroup::onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) {
     // 首先测量自己
-    View::measure(widthMeasureSpec, heightMeasureSpec);
+    View::onMeasure(surface, widthMeasureSpec, heightMeasureSpec);
 
     // 然后测量所有子视图
     for (auto child : _children) {
-        child->measure(_width, _height);
+        child->measure(surface, _width, _height);
     }
 }
 
 void ViewGroup::forceRedraw() {
-    _isDirty = true;
     // 递归标记所有子视图也需要重绘
     for (auto child : _children) {
         child->forceRedraw();
     }
-    // 通知父视图也需要重绘
-    if (_parent && _parent != this) {
-        _parent->markDirty();
-        _parent->notifyParentOfChange();  // 继续向上通知
-    }
+    // 自身区域包含所有子视图区域，上报一次即可
+    markDirty();
 }
 
-bool ViewGroup::isDirty() const {
-    // 如果自身是脏的，返回true
-    if (_isDirty) {
-        return true;
-    }
-    
-    // 检查所有可见的子视图，如果有任意一个需要重绘，返回true
-    for (const auto& child : _children) {
-        if (child->getVisibility() != GONE && child->isDirty()) {
-            return true;
-        }
+void ViewGroup::clearDirty() {
+    for (auto child : _children) {
+        child->clearDirty();
     }
-    
-    // 如果自身和所有可见子视图都不需要重绘，返回false
-    return false;
+    View::clearDirty();
 }
 
 void ViewGroup::notifyParentOfChange() {
@@ -151,6 +168,26 @@ void ViewGroup::notifyParentOfChange() {
     View::notifyParentOfChange();
 }
 
+void ViewGroup::invalidateRect(const Rect& rect) {
+    if (_parent && _parent != this) {
+        _parent->invalidateRect(rect);
+    } else {
+        _dirtyRegion.add(rect);
+        if (s_rootInvalidateHook) {
+            s_rootInvalidateHook();
+        }
+    }
+}
+
+void ViewGroup::setRootInvalidateHook(RootInvalidateHook hook) {
+    s_rootInvalidateHook = hook;
+}
+
+void ViewGroup::takeDirtyRegion(DirtyRegion& region) {
+    region.add(_dirtyRegion);
+    _dirtyRegion.clear();
+}
+
 void ViewGroup::onLayout(int16_t left, int16_t top, int16_t right, int16_t bottom) {
     View::onLayout(left, top, right, bottom);
     ESP_LOGD("ViewGroup", "className :%s, onLayout: left=%d, top=%d, right=%d, bottom=%d", className().c_str(), left, top, right, bottom);
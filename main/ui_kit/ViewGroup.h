@@ -1,6 +1,7 @@
 #pragma once
 
 #include "View.h"
+#include "DirtyRegion.h"
 #include <vector>
 #include <map>
 
@@ -54,7 +55,7 @@ public:
      * @brief 重写绘制方法，同时绘制子视图
      * @param display 显示对象
      */
-    virtual void draw(m5gfx::M5GFX& display) override;
+    virtual void draw(DrawSurface& display) override;
 
     /**
      * @brief 重写触摸处理方法，传递给子视图
@@ -67,36 +68,71 @@ public:
     /**
      * @brief 重写滑动处理方法，传递给子视图
      * @param direction 滑动方向
+     * @param count 连续同向滑动的次数（刷新期间的滑动会被合并）
      * @return 如果处理了事件返回true，否则返回false
      */
-    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction) override;
+    virtual bool onSwipe(TouchGestureDetector::SwipeDirection direction, int count = 1) override;
 
     /**
-     * @brief 重写测量方法，测量所有子视图
-     * @param widthMeasureSpec 父容器提供的宽度约束
-     * @param heightMeasureSpec 父容器提供的高度约束
+     * @brief 强制标记整个视图树为需要重绘
      */
-    virtual void measure(int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+    virtual void forceRedraw() override;
 
     /**
-     * @brief 检查视图组是否需要重绘
-     * @return 如果视图组或其任何可见子视图需要重绘返回true，否则返回false
+     * @brief 丢弃自身及所有子视图的脏标记
      */
-    virtual bool isDirty() const override;
+    virtual void clearDirty() override;
 
     /**
-     * @brief 强制标记整个视图树为需要重绘
+     * @brief 通知父视图需要重绘
      */
-    virtual void forceRedraw() override;
+    virtual void notifyParentOfChange() override;
 
     /**
-     * @brief 通知父视图需要重绘
+     * @brief 记录损坏区域
+     * 
+     * 有父视图时继续向上传递；作为根视图时合并到自身的脏区域集合中
+     * @param rect 损坏区域
      */
-    virtual void notifyParentOfChange() override;
+    virtual void invalidateRect(const Rect& rect) override;
+
+    /**
+     * @brief 取出并清空累积的脏区域
+     * @param region 输出的脏区域
+     */
+    virtual void takeDirtyRegion(DirtyRegion& region) override;
+
+    /**
+     * @brief 根视图收到脏区域时的回调类型
+     */
+    typedef void (*RootInvalidateHook)();
+
+    /**
+     * @brief 设置根视图收到脏区域时的回调（用于唤醒UI循环）
+     * @param hook 回调函数，传入nullptr取消
+     */
+    static void setRootInvalidateHook(RootInvalidateHook hook);
     
 protected:
+    /**
+     * @brief 重写测量方法，测量所有子视图
+     * @param surface 视图所在的绘制表面（用于测量文字）
+     * @param widthMeasureSpec 父容器提供的宽度约束
+     * @param heightMeasureSpec 父容器提供的高度约束
+     */
+    virtual void onMeasure(DrawSurface& surface, int16_t widthMeasureSpec, int16_t heightMeasureSpec) override;
+
+    /**
+     * @brief 绘制所有可见的子视图
+     * @param display 显示对象
+     * @param redrawAll 自身背景已重绘时为true，所有子视图都需要重绘
+     */
+    void drawChildren(DrawSurface& display, bool redrawAll);
+
     virtual void onLayout(int16_t left, int16_t top, int16_t right, int16_t bottom) override;
     std::vector<View*> _children;  ///< 子视图列表
     std::map<View*, Visibility> _lastChildVisibilities;  ///< 记录上次子视图的可见性状态
+    DirtyRegion _dirtyRegion;  ///< 根视图汇总的脏区域
+    static RootInvalidateHook s_rootInvalidateHook;  ///< 根视图收到脏区域时的回调
 
 };
\ No newline at end of file